@@ -45,9 +45,12 @@ public class MythicaEditor : ModuleRules
                 "AssetTools",
                 "Blutility",
                 "Boost",
+                "DerivedDataCache",
                 "DeveloperSettings",
                 "EditorSubsystem",
+                "DynamicMesh",
                 "FileUtilities",
+                "GeometryCore",
                 "HTTP",
                 "ImageCore",
                 "InputCore",
@@ -55,7 +58,6 @@ public class MythicaEditor : ModuleRules
                 "Landscape",
                 "MaterialBaking",
                 "Projects",
-                "PythonScriptPlugin",
                 "Slate",
                 "SlateCore",
                 "ToolMenus",
@@ -72,6 +74,8 @@ public class MythicaEditor : ModuleRules
             );
         
         
+        AddEngineThirdPartyPrivateStaticDependencies(Target, "zlib");
+
         DynamicallyLoadedModuleNames.AddRange(
             new string[]
             {
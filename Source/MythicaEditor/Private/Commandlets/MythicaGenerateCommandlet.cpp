@@ -0,0 +1,441 @@
+#include "Commandlets/MythicaGenerateCommandlet.h"
+
+#include "Async/TaskGraphInterfaces.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Containers/Ticker.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "FileHelpers.h"
+#include "Jobs/MythicaWorldPartitionRegenerate.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "MythicaComponent.h"
+#include "MythicaDeveloperSettings.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+#include "MythicaEditorPrivatePCH.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(MythicaGenerateCommandlet)
+
+const double SessionTimeoutSeconds = 30.0;
+
+static FString GetEnumName(EMythicaJobState State)
+{
+    return StaticEnum<EMythicaJobState>()->GetNameStringByValue((int64)State);
+}
+
+static FString GetEnumName(EMythicaJobCacheResult CacheResult)
+{
+    return StaticEnum<EMythicaJobCacheResult>()->GetNameStringByValue((int64)CacheResult);
+}
+
+UMythicaGenerateCommandlet::UMythicaGenerateCommandlet()
+{
+    IsClient = false;
+    IsEditor = true;
+    IsServer = false;
+    LogToConsole = true;
+    ShowErrorCount = true;
+}
+
+int32 UMythicaGenerateCommandlet::Main(const FString& Params)
+{
+    FString MapsValue;
+    FParse::Value(*Params, TEXT("Maps="), MapsValue, false);
+
+    TArray<FString> Maps;
+    MapsValue.ParseIntoArray(Maps, TEXT("+"));
+    if (Maps.IsEmpty())
+    {
+        UE_LOG(LogMythica, Error, TEXT("No maps given, use -Maps=/Game/Maps/A+/Game/Maps/B"));
+        return 1;
+    }
+
+    FString FilterValue;
+    FParse::Value(*Params, TEXT("Filter="), FilterValue, false);
+    FilterValue.ParseIntoArray(Filters, TEXT("+"));
+
+    ReportPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Mythica"), TEXT("GenerateReport.json"));
+    FParse::Value(*Params, TEXT("Report="), ReportPath);
+
+    FParse::Value(*Params, TEXT("Timeout="), MapTimeoutSeconds);
+    Force = FParse::Param(*Params, TEXT("Force"));
+    Save = !FParse::Param(*Params, TEXT("NoSave"));
+
+    UMythicaDeveloperSettings* Settings = GetMutableDefault<UMythicaDeveloperSettings>();
+
+    int32 Parallel = 0;
+    if (FParse::Value(*Params, TEXT("Parallel="), Parallel) && Parallel > 0)
+    {
+        Settings->MaxConcurrentJobs = Parallel;
+    }
+
+    if (FParse::Param(*Params, TEXT("NoCache")))
+    {
+        Settings->EnableResultCache = false;
+    }
+
+    LastPumpTime = FPlatformTime::Seconds();
+    double StartTime = FPlatformTime::Seconds();
+
+    if (!WaitForSession())
+    {
+        UE_LOG(LogMythica, Error, TEXT("Failed to create a session with %s"), *Settings->GetServiceURL());
+        return 1;
+    }
+
+    UE_LOG(LogMythica, Display, TEXT("Regenerating %d maps against %s with %d parallel jobs"), Maps.Num(), *Settings->GetServiceURL(), Settings->MaxConcurrentJobs);
+
+    UMythicaEditorSubsystem* MythicaEditorSubsystem = GEditor->GetEditorSubsystem<UMythicaEditorSubsystem>();
+    MythicaEditorSubsystem->OnJobCreated.AddUniqueDynamic(this, &UMythicaGenerateCommandlet::OnJobCreated);
+    MythicaEditorSubsystem->OnJobStateChange.AddUniqueDynamic(this, &UMythicaGenerateCommandlet::OnJobStateChanged);
+
+    TArray<FMapReport> MapReports;
+    for (const FString& Map : Maps)
+    {
+        GenerateMap(Map, MapReports.AddDefaulted_GetRef());
+    }
+
+    MythicaEditorSubsystem->OnJobCreated.RemoveDynamic(this, &UMythicaGenerateCommandlet::OnJobCreated);
+    MythicaEditorSubsystem->OnJobStateChange.RemoveDynamic(this, &UMythicaGenerateCommandlet::OnJobStateChanged);
+
+    double TotalSeconds = FPlatformTime::Seconds() - StartTime;
+
+    bool Success = WriteReport(MapReports, TotalSeconds);
+    for (const FMapReport& Report : MapReports)
+    {
+        Success &= Report.Loaded && !Report.TimedOut && Report.Progress.FailedJobs == 0;
+    }
+
+    UE_LOG(LogMythica, Display, TEXT("Mythica generate finished in %.1fs, report written to %s"), TotalSeconds, *ReportPath);
+
+    return Success ? 0 : 1;
+}
+
+bool UMythicaGenerateCommandlet::WaitForSession()
+{
+    UMythicaEditorSubsystem* MythicaEditorSubsystem = GEditor->GetEditorSubsystem<UMythicaEditorSubsystem>();
+    MythicaEditorSubsystem->CreateSession();
+
+    PumpUntil([MythicaEditorSubsystem]()
+    {
+        EMythicaSessionState State = MythicaEditorSubsystem->GetSessionState();
+        return State == EMythicaSessionState::SessionCreated || State == EMythicaSessionState::SessionFailed;
+    }, SessionTimeoutSeconds);
+
+    return MythicaEditorSubsystem->GetSessionState() == EMythicaSessionState::SessionCreated;
+}
+
+void UMythicaGenerateCommandlet::GenerateMap(const FString& MapName, FMapReport& Report)
+{
+    Report.MapName = MapName;
+
+    double LoadStart = FPlatformTime::Seconds();
+    UWorld* World = UEditorLoadingAndSavingUtils::LoadMap(MapName);
+    Report.LoadSeconds = FPlatformTime::Seconds() - LoadStart;
+
+    if (!World)
+    {
+        UE_LOG(LogMythica, Error, TEXT("Failed to load map %s"), *MapName);
+        return;
+    }
+
+    Report.Loaded = true;
+    ActiveRequestIds = &Report.RequestIds;
+
+    double GenerateStart = FPlatformTime::Seconds();
+
+    if (World->IsPartitionedWorld())
+    {
+        if (!WorldPartitionRegenerate)
+        {
+            WorldPartitionRegenerate = NewObject<UMythicaWorldPartitionRegenerate>(this);
+        }
+
+        // Regions are loaded one at a time, so the filter is applied to the components of each region
+        FMythicaComponentFilter Filter;
+        if (!Filters.IsEmpty())
+        {
+            Filter = [this](const UMythicaComponent* Component) { return MatchesFilter(Component); };
+        }
+
+        WorldPartitionRegenerate->Start(World, Force, MoveTemp(Filter));
+
+        UMythicaWorldPartitionRegenerate* Regenerate = WorldPartitionRegenerate;
+        if (!PumpUntil([Regenerate]() { return !Regenerate->IsRunning(); }, MapTimeoutSeconds))
+        {
+            Report.TimedOut = true;
+            WorldPartitionRegenerate->Cancel();
+        }
+
+        Report.Progress = WorldPartitionRegenerate->GetProgress();
+    }
+    else
+    {
+        TArray<UMythicaComponent*> Components;
+        GatherComponents(World, Components);
+
+        MapComponents.Reset();
+        for (UMythicaComponent* Component : Components)
+        {
+            MapComponents.Add(Component);
+        }
+
+        if (!BulkRegenerate)
+        {
+            BulkRegenerate = NewObject<UMythicaBulkRegenerate>(this);
+        }
+
+        BulkRegenerate->Start(Components, Force);
+
+        UMythicaBulkRegenerate* Regenerate = BulkRegenerate;
+        if (!PumpUntil([Regenerate]() { return !Regenerate->IsRunning(); }, MapTimeoutSeconds))
+        {
+            Report.TimedOut = true;
+            BulkRegenerate->Cancel();
+        }
+
+        Report.Progress = BulkRegenerate->GetProgress();
+        MapComponents.Reset();
+    }
+
+    // Jobs canceled on timeout never reach the server, count them as failed
+    if (Report.TimedOut)
+    {
+        UE_LOG(LogMythica, Error, TEXT("Regenerating %s timed out after %.0fs"), *MapName, MapTimeoutSeconds);
+        Report.Progress.FailedJobs += Report.Progress.TotalComponents - Report.Progress.GetFinishedComponents();
+    }
+
+    Report.GenerateSeconds = FPlatformTime::Seconds() - GenerateStart;
+    ActiveRequestIds = nullptr;
+
+    if (Save)
+    {
+        double SaveStart = FPlatformTime::Seconds();
+        UEditorLoadingAndSavingUtils::SaveDirtyPackages(true, true);
+        Report.SaveSeconds = FPlatformTime::Seconds() - SaveStart;
+    }
+
+    UE_LOG(LogMythica, Display, TEXT("%s: %d components, %d completed, %d failed, %d skipped in %.1fs"),
+        *MapName, Report.Progress.TotalComponents, Report.Progress.CompletedJobs, Report.Progress.FailedJobs, Report.Progress.SkippedComponents, Report.GenerateSeconds);
+}
+
+void UMythicaGenerateCommandlet::GatherComponents(UWorld* World, TArray<UMythicaComponent*>& OutComponents) const
+{
+    UMythicaBulkRegenerate::GatherComponents(World, OutComponents);
+
+    if (!Filters.IsEmpty())
+    {
+        OutComponents.RemoveAll([this](const UMythicaComponent* Component) { return !MatchesFilter(Component); });
+    }
+}
+
+bool UMythicaGenerateCommandlet::MatchesFilter(const UMythicaComponent* Component) const
+{
+    const AActor* Owner = Component->GetOwner();
+
+    for (const FString& Filter : Filters)
+    {
+        if (Component->ToolName.Contains(Filter)
+            || Component->GetName().Contains(Filter)
+            || (Owner && (Owner->GetName().Contains(Filter) || Owner->GetActorLabel().Contains(Filter))))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void UMythicaGenerateCommandlet::Pump()
+{
+    double Now = FPlatformTime::Seconds();
+    float DeltaSeconds = (float)(Now - LastPumpTime);
+    LastPumpTime = Now;
+
+    // The editor timer manager only ticks once per frame
+    GFrameCounter++;
+
+    FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+    FTSTicker::GetCoreTicker().Tick(DeltaSeconds);
+    FAssetRegistryModule::TickAssetRegistry(DeltaSeconds);
+    GEditor->GetTimerManager()->Tick(DeltaSeconds);
+
+    FPlatformProcess::Sleep(0.005f);
+}
+
+bool UMythicaGenerateCommandlet::PumpUntil(TFunctionRef<bool()> Condition, double TimeoutSeconds)
+{
+    double StartTime = FPlatformTime::Seconds();
+    while (!Condition())
+    {
+        if (TimeoutSeconds > 0.0 && FPlatformTime::Seconds() - StartTime > TimeoutSeconds)
+        {
+            return false;
+        }
+
+        Pump();
+    }
+
+    return true;
+}
+
+void UMythicaGenerateCommandlet::OnJobCreated(int RequestId, const FString& ComponentId)
+{
+    if (!ActiveRequestIds)
+    {
+        return;
+    }
+
+    ActiveRequestIds->Add(RequestId);
+
+    FJobTiming& Timing = JobTimings.Add(RequestId);
+    Timing.ComponentName = ComponentId;
+    Timing.CreateTime = FPlatformTime::Seconds();
+    Timing.StateBeginTime = Timing.CreateTime;
+
+    UMythicaEditorSubsystem* MythicaEditorSubsystem = GEditor->GetEditorSubsystem<UMythicaEditorSubsystem>();
+    const FMythicaJob* Job = MythicaEditorSubsystem->FindJob(RequestId);
+    if (!Job)
+    {
+        return;
+    }
+
+    Timing.JobDefId = Job->JobDefId;
+    Timing.ImportPath = Job->ImportPath;
+    Timing.State = Job->State;
+
+    // The import path is unique per component
+    for (const TWeakObjectPtr<UMythicaComponent>& WeakComponent : MapComponents)
+    {
+        UMythicaComponent* Component = WeakComponent.Get();
+        if (Component && Component->GetImportPath() == Job->ImportPath)
+        {
+            Timing.ToolName = Component->ToolName;
+            Timing.ActorName = Component->GetOwner() ? Component->GetOwner()->GetActorLabel() : FString();
+            break;
+        }
+    }
+}
+
+void UMythicaGenerateCommandlet::OnJobStateChanged(int RequestId, EMythicaJobState State, FText Message)
+{
+    FJobTiming* Timing = JobTimings.Find(RequestId);
+    if (!Timing || Timing->EndTime > 0.0)
+    {
+        return;
+    }
+
+    double Now = FPlatformTime::Seconds();
+    Timing->StateSeconds.FindOrAdd(Timing->State) += Now - Timing->StateBeginTime;
+    Timing->State = State;
+    Timing->StateBeginTime = Now;
+    Timing->Message = Message.ToString();
+
+    if (State >= EMythicaJobState::Completed)
+    {
+        Timing->EndTime = Now;
+
+        UMythicaEditorSubsystem* MythicaEditorSubsystem = GEditor->GetEditorSubsystem<UMythicaEditorSubsystem>();
+        const FMythicaJob* Job = MythicaEditorSubsystem->FindJob(RequestId);
+        if (Job)
+        {
+            Timing->CacheResult = Job->CacheResult;
+            Timing->Upload = Job->UploadMetrics;
+        }
+    }
+}
+
+bool UMythicaGenerateCommandlet::WriteReport(const TArray<FMapReport>& MapReports, double TotalSeconds) const
+{
+    const UMythicaDeveloperSettings* Settings = GetDefault<UMythicaDeveloperSettings>();
+
+    TArray<TSharedPtr<FJsonValue>> MapArray;
+    for (const FMapReport& Report : MapReports)
+    {
+        TArray<TSharedPtr<FJsonValue>> JobArray;
+        for (int RequestId : Report.RequestIds)
+        {
+            const FJobTiming* Timing = JobTimings.Find(RequestId);
+            if (!Timing)
+            {
+                continue;
+            }
+
+            TSharedPtr<FJsonObject> StateObject = MakeShareable(new FJsonObject);
+            for (const TPair<EMythicaJobState, double>& Pair : Timing->StateSeconds)
+            {
+                StateObject->SetNumberField(GetEnumName(Pair.Key), Pair.Value);
+            }
+
+            double EndTime = Timing->EndTime > 0.0 ? Timing->EndTime : Timing->StateBeginTime;
+
+            TSharedPtr<FJsonObject> JobObject = MakeShareable(new FJsonObject);
+            JobObject->SetNumberField(TEXT("request_id"), RequestId);
+            JobObject->SetStringField(TEXT("component"), Timing->ComponentName);
+            JobObject->SetStringField(TEXT("actor"), Timing->ActorName);
+            JobObject->SetStringField(TEXT("tool"), Timing->ToolName);
+            JobObject->SetStringField(TEXT("job_def_id"), Timing->JobDefId);
+            JobObject->SetStringField(TEXT("import_path"), Timing->ImportPath);
+            JobObject->SetStringField(TEXT("state"), GetEnumName(Timing->State));
+            JobObject->SetStringField(TEXT("cache_result"), GetEnumName(Timing->CacheResult));
+            JobObject->SetStringField(TEXT("message"), Timing->Message);
+            JobObject->SetNumberField(TEXT("total_seconds"), EndTime - Timing->CreateTime);
+            JobObject->SetObjectField(TEXT("state_seconds"), StateObject);
+
+            if (Timing->Upload.Files > 0)
+            {
+                TSharedPtr<FJsonObject> UploadObject = MakeShareable(new FJsonObject);
+                UploadObject->SetNumberField(TEXT("files"), Timing->Upload.Files);
+                UploadObject->SetNumberField(TEXT("raw_bytes"), Timing->Upload.RawBytes);
+                UploadObject->SetNumberField(TEXT("sent_bytes"), Timing->Upload.SentBytes);
+                UploadObject->SetNumberField(TEXT("compression_ratio"), Timing->Upload.GetCompressionRatio());
+                UploadObject->SetNumberField(TEXT("compress_seconds"), Timing->Upload.CompressSeconds);
+                UploadObject->SetNumberField(TEXT("upload_seconds"), Timing->Upload.UploadSeconds);
+                UploadObject->SetNumberField(TEXT("seconds_saved"), Timing->Upload.SecondsSaved);
+                UploadObject->SetNumberField(TEXT("stripped_bytes"), Timing->Upload.StrippedBytes);
+                JobObject->SetObjectField(TEXT("upload"), UploadObject);
+            }
+
+            JobArray.Add(MakeShareable(new FJsonValueObject(JobObject)));
+        }
+
+        TSharedPtr<FJsonObject> MapObject = MakeShareable(new FJsonObject);
+        MapObject->SetStringField(TEXT("map"), Report.MapName);
+        MapObject->SetBoolField(TEXT("loaded"), Report.Loaded);
+        MapObject->SetBoolField(TEXT("timed_out"), Report.TimedOut);
+        MapObject->SetNumberField(TEXT("load_seconds"), Report.LoadSeconds);
+        MapObject->SetNumberField(TEXT("generate_seconds"), Report.GenerateSeconds);
+        MapObject->SetNumberField(TEXT("save_seconds"), Report.SaveSeconds);
+        MapObject->SetNumberField(TEXT("components"), Report.Progress.TotalComponents);
+        MapObject->SetNumberField(TEXT("completed"), Report.Progress.CompletedJobs);
+        MapObject->SetNumberField(TEXT("failed"), Report.Progress.FailedJobs);
+        MapObject->SetNumberField(TEXT("skipped"), Report.Progress.SkippedComponents);
+        MapObject->SetNumberField(TEXT("average_job_seconds"), Report.Progress.AverageJobSeconds);
+        MapObject->SetNumberField(TEXT("jobs_per_minute"), Report.Progress.JobsPerMinute);
+        MapObject->SetArrayField(TEXT("jobs"), JobArray);
+
+        MapArray.Add(MakeShareable(new FJsonValueObject(MapObject)));
+    }
+
+    TSharedPtr<FJsonObject> JsonObject = MakeShareable(new FJsonObject);
+    JsonObject->SetStringField(TEXT("service_url"), Settings->GetServiceURL());
+    JsonObject->SetNumberField(TEXT("parallel_jobs"), Settings->MaxConcurrentJobs);
+    JsonObject->SetBoolField(TEXT("force"), Force);
+    JsonObject->SetBoolField(TEXT("result_cache"), Settings->EnableResultCache);
+    JsonObject->SetNumberField(TEXT("total_seconds"), TotalSeconds);
+    JsonObject->SetArrayField(TEXT("maps"), MapArray);
+
+    FString ReportContent;
+    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ReportContent);
+    FJsonSerializer::Serialize(JsonObject.ToSharedRef(), Writer);
+
+    if (!FFileHelper::SaveStringToFile(ReportContent, *ReportPath))
+    {
+        UE_LOG(LogMythica, Error, TEXT("Failed to write report %s"), *ReportPath);
+        return false;
+    }
+
+    return true;
+}
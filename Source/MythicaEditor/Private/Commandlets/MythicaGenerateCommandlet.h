@@ -0,0 +1,110 @@
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "CoreMinimal.h"
+#include "Jobs/MythicaBulkRegenerate.h"
+#include "MythicaEditorSubsystem.h"
+
+#include "MythicaGenerateCommandlet.generated.h"
+
+class UMythicaComponent;
+
+/**
+ * UMythicaGenerateCommandlet
+ *
+ * Regenerates the Mythica components of one or more maps without the editor UI and writes a JSON timing report.
+ * Used for nightly rebakes and to catch performance regressions on build machines.
+ *
+ * UnrealEditor-Cmd <Project> -run=MythicaGenerate -Maps=/Game/Maps/A+/Game/Maps/B [options]
+ *
+ *   -Maps=<Map>+<Map>    Maps to regenerate
+ *   -Filter=<A>+<B>      Only regenerate components whose tool, component or actor name contains one of the filters
+ *   -Parallel=<N>        Number of jobs in flight at once, overrides MaxConcurrentJobs
+ *   -Force               Regenerate components whose inputs are unchanged
+ *   -NoCache             Disable the result caches so every job goes to the server
+ *   -NoSave              Don't save the regenerated maps
+ *   -Timeout=<Seconds>   Time budget per map, remaining jobs are canceled and counted as failed
+ *   -Report=<Path>       Location of the timing report, defaults to Saved/Mythica/GenerateReport.json
+ *
+ * The service is configured through the plugin settings, use -ini:Plugins:[/Script/MythicaEditor.MythicaDeveloperSettings]:Environment=Local
+ * to run against the stand-in service in Tools/StandInService.
+ */
+UCLASS()
+class UMythicaGenerateCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+
+    UMythicaGenerateCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+
+private:
+
+    struct FJobTiming
+    {
+        FString ComponentName;
+        FString ActorName;
+        FString ToolName;
+        FString JobDefId;
+        FString ImportPath;
+        EMythicaJobState State = EMythicaJobState::Scheduled;
+        EMythicaJobCacheResult CacheResult = EMythicaJobCacheResult::None;
+        FString Message;
+        double CreateTime = 0.0;
+        double StateBeginTime = 0.0;
+        double EndTime = 0.0;
+        TMap<EMythicaJobState, double> StateSeconds;
+        FMythicaUploadMetrics Upload;
+    };
+
+    struct FMapReport
+    {
+        FString MapName;
+        bool Loaded = false;
+        bool TimedOut = false;
+        double LoadSeconds = 0.0;
+        double GenerateSeconds = 0.0;
+        double SaveSeconds = 0.0;
+        FMythicaBulkRegenerateProgress Progress;
+        TArray<int> RequestIds;
+    };
+
+    bool WaitForSession();
+    void GenerateMap(const FString& MapName, FMapReport& Report);
+    void GatherComponents(UWorld* World, TArray<UMythicaComponent*>& OutComponents) const;
+    bool MatchesFilter(const UMythicaComponent* Component) const;
+
+    /** Ticks the http, ticker and editor timer systems the editor loop would otherwise tick */
+    void Pump();
+    bool PumpUntil(TFunctionRef<bool()> Condition, double TimeoutSeconds);
+
+    bool WriteReport(const TArray<FMapReport>& MapReports, double TotalSeconds) const;
+
+    UFUNCTION()
+    void OnJobCreated(int RequestId, const FString& ComponentId);
+
+    UFUNCTION()
+    void OnJobStateChanged(int RequestId, EMythicaJobState State, FText Message);
+
+    TArray<FString> Filters;
+    FString ReportPath;
+    double MapTimeoutSeconds = 0.0;
+    bool Force = false;
+    bool Save = true;
+
+    /** Components of the map being regenerated, used to attribute jobs to actors */
+    TArray<TWeakObjectPtr<UMythicaComponent>> MapComponents;
+
+    TMap<int, FJobTiming> JobTimings;
+    TArray<int>* ActiveRequestIds = nullptr;
+
+    double LastPumpTime = 0.0;
+
+    UPROPERTY()
+    TObjectPtr<UMythicaBulkRegenerate> BulkRegenerate = nullptr;
+
+    UPROPERTY()
+    TObjectPtr<class UMythicaWorldPartitionRegenerate> WorldPartitionRegenerate = nullptr;
+};
@@ -0,0 +1,452 @@
+#include "Jobs/MythicaBulkRegenerate.h"
+
+#include "EngineUtils.h"
+#include "Framework/Notifications/NotificationManager.h"
+#include "MythicaComponent.h"
+#include "MythicaInputSelectionVolume.h"
+#include "Widgets/Notifications/SNotificationList.h"
+
+#include "MythicaEditorPrivatePCH.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(MythicaBulkRegenerate)
+
+#define LOCTEXT_NAMESPACE MYTHICA_LOCTEXT_NAMESPACE
+
+void UMythicaBulkRegenerate::GetInputActors(const UMythicaComponent* Component, TSet<AActor*>& OutActors)
+{
+    for (const FMythicaParameter& Param : Component->Parameters.Parameters)
+    {
+        if (Param.Type != EMythicaParameterType::File)
+        {
+            continue;
+        }
+
+        const FMythicaParameterFile& File = Param.ValueFile;
+        if (File.Type == EMythicaInputType::World)
+        {
+            OutActors.Append(File.Actors);
+        }
+        else if (File.Type == EMythicaInputType::Volume && File.VolumeActor)
+        {
+            TArray<AActor*> VolumeActors;
+            File.VolumeActor->GetActors(VolumeActors);
+            OutActors.Append(VolumeActors);
+        }
+    }
+}
+
+void UMythicaBulkRegenerate::GatherComponents(UWorld* World, TArray<UMythicaComponent*>& OutComponents)
+{
+    if (!World)
+    {
+        return;
+    }
+
+    for (TActorIterator<AActor> It(World); It; ++It)
+    {
+        TArray<UMythicaComponent*> ActorComponents;
+        It->GetComponents<UMythicaComponent>(ActorComponents);
+        OutComponents.Append(ActorComponents);
+    }
+}
+
+void UMythicaBulkRegenerate::Start(UWorld* World, bool bForce)
+{
+    TArray<UMythicaComponent*> Components;
+    GatherComponents(World, Components);
+
+    Start(Components, bForce);
+}
+
+void UMythicaBulkRegenerate::Start(const TArray<UMythicaComponent*>& Components, bool bForce)
+{
+    if (Running)
+    {
+        UE_LOG(LogMythica, Warning, TEXT("Bulk regenerate is already running"));
+        return;
+    }
+
+    Running = true;
+    Force = bForce;
+    StartTime = FPlatformTime::Seconds();
+    TotalJobSeconds = 0.0;
+    Progress = FMythicaBulkRegenerateProgress();
+    RequestToNode.Reset();
+    ReadyNodes.Reset();
+
+    BuildGraph(Components);
+    Progress.TotalComponents = Nodes.Num();
+
+    UE_LOG(LogMythica, Log, TEXT("Bulk regenerating %d components, %d waiting on inputs"), Nodes.Num(), Nodes.Num() - ReadyNodes.Num());
+
+    UMythicaEditorSubsystem* MythicaEditorSubsystem = GEditor->GetEditorSubsystem<UMythicaEditorSubsystem>();
+    MythicaEditorSubsystem->OnJobStateChange.AddUniqueDynamic(this, &UMythicaBulkRegenerate::OnJobStateChanged);
+
+    if (FSlateApplication::IsInitialized())
+    {
+        FNotificationInfo Info(LOCTEXT("BulkRegenerateStarted", "Regenerating Mythica components..."));
+        Info.bFireAndForget = false;
+        Info.bUseThrobber = true;
+        Notification = FSlateNotificationManager::Get().AddNotification(Info);
+        if (Notification.IsValid())
+        {
+            Notification->SetCompletionState(SNotificationItem::CS_Pending);
+        }
+    }
+
+    SubmitReadyNodes();
+}
+
+void UMythicaBulkRegenerate::Cancel()
+{
+    if (!Running)
+    {
+        return;
+    }
+
+    UMythicaEditorSubsystem* MythicaEditorSubsystem = GEditor->GetEditorSubsystem<UMythicaEditorSubsystem>();
+
+    ReadyNodes.Reset();
+    for (FNode& Node : Nodes)
+    {
+        if (Node.Submitted && !Node.Finished && Node.RequestId > 0)
+        {
+            MythicaEditorSubsystem->CancelJob(Node.RequestId);
+        }
+    }
+
+    Finish();
+}
+
+void UMythicaBulkRegenerate::BuildGraph(const TArray<UMythicaComponent*>& Components)
+{
+    Nodes.Reset();
+
+    TMap<AActor*, TArray<int32>> ActorToNodes;
+    for (UMythicaComponent* Component : Components)
+    {
+        if (!IsValid(Component) || !Component->GetOwner())
+        {
+            continue;
+        }
+
+        int32 NodeIndex = Nodes.AddDefaulted();
+        Nodes[NodeIndex].Component = Component;
+        ActorToNodes.FindOrAdd(Component->GetOwner()).Add(NodeIndex);
+    }
+
+    // A component depends on every component whose actor, and with it the generated meshes, it takes as input
+    for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); ++NodeIndex)
+    {
+        UMythicaComponent* Component = Nodes[NodeIndex].Component.Get();
+
+        TSet<AActor*> InputActors;
+        GetInputActors(Component, InputActors);
+
+        for (AActor* InputActor : InputActors)
+        {
+            const TArray<int32>* Producers = ActorToNodes.Find(InputActor);
+            if (!Producers)
+            {
+                continue;
+            }
+
+            for (int32 Producer : *Producers)
+            {
+                if (Producer != NodeIndex && !Nodes[Producer].Dependents.Contains(NodeIndex))
+                {
+                    Nodes[Producer].Dependents.Add(NodeIndex);
+                    Nodes[NodeIndex].PendingDependencies++;
+                }
+            }
+        }
+    }
+
+    BreakCycles();
+
+    for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); ++NodeIndex)
+    {
+        if (Nodes[NodeIndex].PendingDependencies == 0)
+        {
+            ReadyNodes.Add(NodeIndex);
+        }
+    }
+}
+
+void UMythicaBulkRegenerate::BreakCycles()
+{
+    // Components that take each other's actors as input can't wait on each other. Find the strongly connected
+    // components with Tarjan's algorithm and drop the edges inside them, so the members of a cycle run together
+    // once their producers outside the cycle finished, and their dependents still wait for them.
+    TArray<int32> Index;
+    TArray<int32> LowLink;
+    TArray<bool> OnStack;
+    Index.Init(INDEX_NONE, Nodes.Num());
+    LowLink.Init(0, Nodes.Num());
+    OnStack.Init(false, Nodes.Num());
+
+    TArray<int32> Stack;
+    TArray<int32> Scc;
+    Scc.Init(INDEX_NONE, Nodes.Num());
+    int32 NextIndex = 0;
+    int32 NumSccs = 0;
+
+    // Iterative to stay clear of the stack depth limit on long chains, each frame is a node and its next edge
+    TArray<TPair<int32, int32>> CallStack;
+    for (int32 Root = 0; Root < Nodes.Num(); ++Root)
+    {
+        if (Index[Root] != INDEX_NONE)
+        {
+            continue;
+        }
+
+        CallStack.Add({ Root, 0 });
+        while (!CallStack.IsEmpty())
+        {
+            int32 NodeIndex = CallStack.Last().Key;
+            int32& EdgeIndex = CallStack.Last().Value;
+
+            if (EdgeIndex == 0 && Index[NodeIndex] == INDEX_NONE)
+            {
+                Index[NodeIndex] = LowLink[NodeIndex] = NextIndex++;
+                Stack.Push(NodeIndex);
+                OnStack[NodeIndex] = true;
+            }
+
+            const TArray<int32>& Dependents = Nodes[NodeIndex].Dependents;
+            if (EdgeIndex < Dependents.Num())
+            {
+                int32 Dependent = Dependents[EdgeIndex++];
+                if (Index[Dependent] == INDEX_NONE)
+                {
+                    CallStack.Add({ Dependent, 0 });
+                }
+                else if (OnStack[Dependent])
+                {
+                    LowLink[NodeIndex] = FMath::Min(LowLink[NodeIndex], Index[Dependent]);
+                }
+                continue;
+            }
+
+            if (LowLink[NodeIndex] == Index[NodeIndex])
+            {
+                int32 Member;
+                do
+                {
+                    Member = Stack.Pop();
+                    OnStack[Member] = false;
+                    Scc[Member] = NumSccs;
+                } while (Member != NodeIndex);
+                NumSccs++;
+            }
+
+            CallStack.Pop();
+            if (!CallStack.IsEmpty())
+            {
+                int32 Parent = CallStack.Last().Key;
+                LowLink[Parent] = FMath::Min(LowLink[Parent], LowLink[NodeIndex]);
+            }
+        }
+    }
+
+    TArray<int32> SccSizes;
+    SccSizes.Init(0, NumSccs);
+    for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); ++NodeIndex)
+    {
+        SccSizes[Scc[NodeIndex]]++;
+    }
+
+    for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); ++NodeIndex)
+    {
+        Nodes[NodeIndex].Dependents.RemoveAll([this, &Scc, NodeIndex](int32 Dependent)
+        {
+            if (Scc[Dependent] != Scc[NodeIndex])
+            {
+                return false;
+            }
+
+            Nodes[Dependent].PendingDependencies--;
+            return true;
+        });
+    }
+
+    for (int32 Size : SccSizes)
+    {
+        if (Size > 1)
+        {
+            UE_LOG(LogMythica, Warning, TEXT("Bulk regenerate found a cycle of %d components that take each other as input, they are regenerated together"), Size);
+        }
+    }
+}
+
+void UMythicaBulkRegenerate::SubmitReadyNodes()
+{
+    SubmitTimer.Invalidate();
+
+    // Skipped components release their dependents right away
+    while (!ReadyNodes.IsEmpty())
+    {
+        TArray<int32> NodesToSubmit = MoveTemp(ReadyNodes);
+        for (int32 NodeIndex : NodesToSubmit)
+        {
+            SubmitNode(NodeIndex);
+        }
+    }
+
+    UpdateProgress();
+
+    if (Running && Progress.GetFinishedComponents() >= Progress.TotalComponents)
+    {
+        Finish();
+    }
+}
+
+void UMythicaBulkRegenerate::SubmitNode(int32 NodeIndex)
+{
+    FNode& Node = Nodes[NodeIndex];
+    Node.Submitted = true;
+    Node.SubmitTime = FPlatformTime::Seconds();
+
+    UMythicaComponent* Component = Node.Component.Get();
+    if (!IsValid(Component))
+    {
+        FinishNode(NodeIndex, EMythicaJobState::Failed);
+        return;
+    }
+
+    EMythicaRegenerateResult Result = Component->RegenerateMesh(Force);
+    if (Result == EMythicaRegenerateResult::Unchanged)
+    {
+        Progress.SkippedComponents++;
+        FinishNode(NodeIndex, EMythicaJobState::Invalid);
+        return;
+    }
+
+    int RequestId = Component->GetRequestId();
+    if (Result == EMythicaRegenerateResult::Failed || RequestId <= 0)
+    {
+        UE_LOG(LogMythica, Error, TEXT("Failed to create job for %s: %s"), *Component->GetName(), *Component->GetJobMessage().ToString());
+        FinishNode(NodeIndex, EMythicaJobState::Failed);
+        return;
+    }
+
+    Node.RequestId = RequestId;
+    RequestToNode.Add(RequestId, NodeIndex);
+    Progress.InFlightJobs++;
+}
+
+void UMythicaBulkRegenerate::FinishNode(int32 NodeIndex, EMythicaJobState State)
+{
+    FNode& Node = Nodes[NodeIndex];
+    if (Node.Finished)
+    {
+        return;
+    }
+    Node.Finished = true;
+
+    if (Node.RequestId > 0)
+    {
+        Progress.InFlightJobs = FMath::Max(Progress.InFlightJobs - 1, 0);
+        TotalJobSeconds += FPlatformTime::Seconds() - Node.SubmitTime;
+
+        if (State == EMythicaJobState::Completed)
+        {
+            Progress.CompletedJobs++;
+        }
+        else
+        {
+            Progress.FailedJobs++;
+        }
+    }
+    else if (State == EMythicaJobState::Failed)
+    {
+        Progress.FailedJobs++;
+    }
+
+    for (int32 Dependent : Node.Dependents)
+    {
+        if (--Nodes[Dependent].PendingDependencies == 0)
+        {
+            ReadyNodes.Add(Dependent);
+        }
+    }
+}
+
+void UMythicaBulkRegenerate::OnJobStateChanged(int RequestId, EMythicaJobState State, FText Message)
+{
+    if (State < EMythicaJobState::Completed)
+    {
+        return;
+    }
+
+    int32 NodeIndex;
+    if (!RequestToNode.RemoveAndCopyValue(RequestId, NodeIndex))
+    {
+        return;
+    }
+
+    FinishNode(NodeIndex, State);
+
+    // Submit dependents on the next tick once the producing component has updated its meshes
+    if (!GEditor->GetTimerManager()->TimerExists(SubmitTimer))
+    {
+        SubmitTimer = GEditor->GetTimerManager()->SetTimerForNextTick(FTimerDelegate::CreateUObject(this, &UMythicaBulkRegenerate::SubmitReadyNodes));
+    }
+}
+
+void UMythicaBulkRegenerate::UpdateProgress()
+{
+    Progress.BlockedComponents = 0;
+    for (const FNode& Node : Nodes)
+    {
+        if (!Node.Submitted)
+        {
+            Progress.BlockedComponents++;
+        }
+    }
+
+    int32 FinishedJobs = Progress.CompletedJobs + Progress.FailedJobs;
+    Progress.ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+    Progress.AverageJobSeconds = FinishedJobs > 0 ? TotalJobSeconds / FinishedJobs : 0.0;
+    Progress.JobsPerMinute = Progress.ElapsedSeconds > 0.0 ? FinishedJobs * 60.0 / Progress.ElapsedSeconds : 0.0;
+
+    if (Notification.IsValid())
+    {
+        Notification->SetText(FText::Format(
+            LOCTEXT("BulkRegenerateProgress", "Regenerating Mythica components {0}/{1} ({2} jobs/min)"),
+            Progress.GetFinishedComponents(),
+            Progress.TotalComponents,
+            FText::AsNumber(Progress.JobsPerMinute, &FNumberFormattingOptions::DefaultNoGrouping().SetMaximumFractionalDigits(1))));
+    }
+
+    OnProgress.Broadcast(Progress);
+}
+
+void UMythicaBulkRegenerate::Finish()
+{
+    Running = false;
+
+    UMythicaEditorSubsystem* MythicaEditorSubsystem = GEditor->GetEditorSubsystem<UMythicaEditorSubsystem>();
+    MythicaEditorSubsystem->OnJobStateChange.RemoveDynamic(this, &UMythicaBulkRegenerate::OnJobStateChanged);
+    GEditor->GetTimerManager()->ClearTimer(SubmitTimer);
+
+    UpdateProgress();
+
+    UE_LOG(LogMythica, Log, TEXT("Bulk regenerate finished in %.1fs: %d completed, %d failed, %d skipped, %.1f jobs/min, %.2fs average job"),
+        Progress.ElapsedSeconds, Progress.CompletedJobs, Progress.FailedJobs, Progress.SkippedComponents, Progress.JobsPerMinute, Progress.AverageJobSeconds);
+
+    if (Notification.IsValid())
+    {
+        Notification->SetCompletionState(Progress.FailedJobs > 0 ? SNotificationItem::CS_Fail : SNotificationItem::CS_Success);
+        Notification->ExpireAndFadeout();
+        Notification.Reset();
+    }
+
+    Nodes.Reset();
+    RequestToNode.Reset();
+    ReadyNodes.Reset();
+
+    OnFinished.Broadcast(Progress);
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MythicaEditorSubsystem.h"
+#include "UObject/Object.h"
+
+#include "MythicaBulkRegenerate.generated.h"
+
+class SNotificationItem;
+class UMythicaComponent;
+
+USTRUCT(BlueprintType)
+struct FMythicaBulkRegenerateProgress
+{
+    GENERATED_BODY()
+
+public:
+
+    UPROPERTY(BlueprintReadOnly, Category = "Data")
+    int32 TotalComponents = 0;
+
+    /** Components whose inputs were unchanged so no job was submitted */
+    UPROPERTY(BlueprintReadOnly, Category = "Data")
+    int32 SkippedComponents = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Data")
+    int32 CompletedJobs = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Data")
+    int32 FailedJobs = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Data")
+    int32 InFlightJobs = 0;
+
+    /** Components waiting on the components they take inputs from */
+    UPROPERTY(BlueprintReadOnly, Category = "Data")
+    int32 BlockedComponents = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Data")
+    double ElapsedSeconds = 0.0;
+
+    /** Average time from submitting a job to its final state */
+    UPROPERTY(BlueprintReadOnly, Category = "Data")
+    double AverageJobSeconds = 0.0;
+
+    /** Finished jobs per minute of wall clock time */
+    UPROPERTY(BlueprintReadOnly, Category = "Data")
+    double JobsPerMinute = 0.0;
+
+    int32 GetFinishedComponents() const { return SkippedComponents + CompletedJobs + FailedJobs; }
+    float GetPercent() const { return TotalComponents > 0 ? (float)GetFinishedComponents() / TotalComponents : 1.0f; }
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnBulkRegenerateProgress, const FMythicaBulkRegenerateProgress&, Progress);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnBulkRegenerateFinished, const FMythicaBulkRegenerateProgress&, Progress);
+
+/**
+ * UMythicaBulkRegenerate
+ *
+ * Regenerates a set of components as one operation. A component that takes another component's actor as a
+ * World or Volume input is only submitted once that component has finished, everything else is submitted
+ * right away and runs in parallel up to the job scheduler's concurrency limit.
+ */
+UCLASS()
+class UMythicaBulkRegenerate : public UObject
+{
+    GENERATED_BODY()
+
+public:
+
+    /** Regenerate every Mythica component in the world */
+    void Start(UWorld* World, bool bForce);
+
+    /** Regenerate the given components */
+    void Start(const TArray<UMythicaComponent*>& Components, bool bForce);
+
+    /** Cancel the jobs that are in flight and drop the components that haven't been submitted */
+    void Cancel();
+
+    bool IsRunning() const { return Running; }
+    const FMythicaBulkRegenerateProgress& GetProgress() const { return Progress; }
+
+    static void GatherComponents(UWorld* World, TArray<UMythicaComponent*>& OutComponents);
+
+    /** Actors the component takes as World or Volume input, their Mythica components are its producers */
+    static void GetInputActors(const UMythicaComponent* Component, TSet<AActor*>& OutActors);
+
+    UPROPERTY(BlueprintAssignable, Category = "Mythica")
+    FOnBulkRegenerateProgress OnProgress;
+
+    UPROPERTY(BlueprintAssignable, Category = "Mythica")
+    FOnBulkRegenerateFinished OnFinished;
+
+private:
+
+    struct FNode
+    {
+        TWeakObjectPtr<UMythicaComponent> Component;
+        TArray<int32> Dependents;
+        int32 PendingDependencies = 0;
+        int RequestId = -1;
+        double SubmitTime = 0.0;
+        bool Submitted = false;
+        bool Finished = false;
+    };
+
+    void BuildGraph(const TArray<UMythicaComponent*>& Components);
+    void BreakCycles();
+    void SubmitReadyNodes();
+    void SubmitNode(int32 NodeIndex);
+    void FinishNode(int32 NodeIndex, EMythicaJobState State);
+    void UpdateProgress();
+    void Finish();
+
+    UFUNCTION()
+    void OnJobStateChanged(int RequestId, EMythicaJobState State, FText Message);
+
+    TArray<FNode> Nodes;
+    TMap<int, int32> RequestToNode;
+    TArray<int32> ReadyNodes;
+
+    FMythicaBulkRegenerateProgress Progress;
+    double StartTime = 0.0;
+    double TotalJobSeconds = 0.0;
+    bool Force = false;
+    bool Running = false;
+
+    FTimerHandle SubmitTimer;
+    TSharedPtr<SNotificationItem> Notification;
+};
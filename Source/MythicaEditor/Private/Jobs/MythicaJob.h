@@ -59,6 +59,7 @@
 //    FString SourceAssetOwner;
 //};
 
+/** Scheduling record of a job waiting for, or holding, one of the in flight job slots */
 USTRUCT(BlueprintType)
 struct FMythicaJobRecord
 {
@@ -67,16 +68,7 @@ struct FMythicaJobRecord
 public:
 
     UPROPERTY(BlueprintReadOnly, Category = "Data")
-    FString JobDefId = FString();
-
-    UPROPERTY(BlueprintReadOnly, Category = "Data")
-    TArray<FString> InputFileIds = TArray<FString>();
-
-    UPROPERTY(BlueprintReadOnly, Category = "Data")
-    FMythicaParameters Params = FMythicaParameters();
-
-    UPROPERTY(BlueprintReadOnly, Category = "Data")
-    FString ImportPath = FString();
+    int RequestId = -1;
 
     UPROPERTY(BlueprintReadOnly, Category = "Data")
     TWeakObjectPtr<class UMythicaComponent> OwningComponent = nullptr;
@@ -84,24 +76,12 @@ public:
     UPROPERTY(BlueprintReadOnly, Category = "Data")
     FString OwningComponentName = FString();
 
-    //UPROPERTY(BlueprintReadOnly, Category = "Data")
-    //EMythicaJobState State = EMythicaJobState::Requesting;
-
-    UPROPERTY(BlueprintReadOnly, Category = "Data")
-    FTimerHandle TimeoutTimer;
-
-    UPROPERTY(BlueprintReadOnly, Category = "Data")
-    FString JobId = FString();
-
-    UPROPERTY(BlueprintReadOnly, Category = "Data")
-    FString ImportDirectory = FString();
-
-    /** The system time of the machine at the time the job was created */
+    /** Jobs with a higher priority are started first */
     UPROPERTY(BlueprintReadOnly, Category = "Data")
-    FDateTime StartTime = FDateTime();
+    int32 Priority = 0;
 
-    /** The system time of the machine at the time the job was completed */
+    /** The system time of the machine at the time the job was queued */
     UPROPERTY(BlueprintReadOnly, Category = "Data")
-    FDateTime EndTime = FDateTime();
+    FDateTime QueueTime = FDateTime();
 
 };
@@ -0,0 +1,229 @@
+#include "Jobs/MythicaJobFingerprint.h"
+
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/SplineComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Hash/Blake3.h"
+#include "MythicaInputSelectionVolume.h"
+#include "MythicaTypes.h"
+#include "StaticMeshResources.h"
+
+#include "MythicaEditorPrivatePCH.h"
+
+template <typename T>
+static void HashValue(FBlake3& Hasher, const T& Value)
+{
+    Hasher.Update(&Value, sizeof(T));
+}
+
+template <typename T>
+static void HashArray(FBlake3& Hasher, const TArray<T>& Values)
+{
+    HashValue(Hasher, Values.Num());
+    Hasher.Update(Values.GetData(), Values.Num() * sizeof(T));
+}
+
+static void HashString(FBlake3& Hasher, const FString& Value)
+{
+    HashValue(Hasher, Value.Len());
+    Hasher.Update(*Value, Value.Len() * sizeof(TCHAR));
+}
+
+static void HashTransform(FBlake3& Hasher, const FTransform& Transform)
+{
+    HashValue(Hasher, Transform.GetLocation());
+    HashValue(Hasher, Transform.GetRotation());
+    HashValue(Hasher, Transform.GetScale3D());
+}
+
+static void HashActor(FBlake3& Hasher, const AActor* Actor)
+{
+    if (!Actor)
+    {
+        HashValue(Hasher, 0);
+        return;
+    }
+
+    HashString(Hasher, Actor->GetPathName());
+    HashTransform(Hasher, Actor->GetActorTransform());
+
+    TArray<UStaticMeshComponent*> MeshComponents;
+    Actor->GetComponents<UStaticMeshComponent>(MeshComponents);
+
+    HashValue(Hasher, MeshComponents.Num());
+    for (const UStaticMeshComponent* Component : MeshComponents)
+    {
+        HashString(Hasher, Mythica::GetStaticMeshContentKey(Component->GetStaticMesh()));
+        HashTransform(Hasher, Component->GetComponentTransform());
+
+        for (int32 i = 0; i < Component->GetNumMaterials(); ++i)
+        {
+            const UMaterialInterface* Material = Component->GetMaterial(i);
+            HashString(Hasher, Material ? Material->GetPathName() : FString());
+        }
+
+        const UInstancedStaticMeshComponent* InstancedComponent = Cast<UInstancedStaticMeshComponent>(Component);
+        if (InstancedComponent)
+        {
+            HashArray(Hasher, InstancedComponent->PerInstanceSMData);
+        }
+    }
+}
+
+static void HashActors(FBlake3& Hasher, const TArray<AActor*>& Actors)
+{
+    HashValue(Hasher, Actors.Num());
+    for (const AActor* Actor : Actors)
+    {
+        HashActor(Hasher, Actor);
+    }
+}
+
+FString Mythica::GetStaticMeshContentKey(const UStaticMesh* Mesh)
+{
+    if (!Mesh)
+    {
+        return FString();
+    }
+
+    // The derived data key covers the source mesh description and build settings. Fall back to the lighting guid
+    // which is regenerated whenever the mesh is edited.
+    const FStaticMeshRenderData* RenderData = Mesh->GetRenderData();
+    if (RenderData && !RenderData->DerivedDataKey.IsEmpty())
+    {
+        return Mesh->GetPathName() + TEXT(":") + RenderData->DerivedDataKey;
+    }
+
+    return Mesh->GetPathName() + TEXT(":") + Mesh->GetLightingGuid().ToString();
+}
+
+FString Mythica::GetStaticMeshMaterialKey(const UStaticMesh* Mesh)
+{
+    if (!Mesh)
+    {
+        return FString();
+    }
+
+    FString Key;
+    for (const FStaticMaterial& StaticMaterial : Mesh->GetStaticMaterials())
+    {
+        FString MaterialPath = StaticMaterial.MaterialInterface ? StaticMaterial.MaterialInterface->GetPathName() : FString();
+        Key += FString::Printf(TEXT("%s=%s;"), *StaticMaterial.MaterialSlotName.ToString(), *MaterialPath);
+    }
+    return Key;
+}
+
+FIoHash Mythica::ComputeInputFingerprint(const FMythicaParameterFile& Input, const FVector& Origin)
+{
+    FBlake3 Hasher;
+    HashValue(Hasher, Input.Type);
+    HashValue(Hasher, Input.Settings.TransformType);
+    HashValue(Hasher, Input.Settings.ExportProfile);
+    HashValue(Hasher, Input.Settings.ExportFormat);
+    HashValue(Hasher, Input.Settings.MeshLOD);
+    HashValue(Hasher, Input.Settings.MeshTriangleBudget);
+
+    // The origin only affects exports that are relative to it
+    if (Input.Type != EMythicaInputType::Mesh && Input.Settings.TransformType == EMythicaExportTransformType::Relative)
+    {
+        HashValue(Hasher, Origin);
+    }
+
+    switch (Input.Type)
+    {
+        case EMythicaInputType::Mesh:
+        {
+            HashString(Hasher, Mythica::GetStaticMeshContentKey(Input.Mesh));
+
+            // Geometry only exports leave the materials out
+            if (Input.Settings.ExportProfile != EMythicaExportProfile::GeometryOnly)
+            {
+                HashString(Hasher, Mythica::GetStaticMeshMaterialKey(Input.Mesh));
+            }
+            break;
+        }
+        case EMythicaInputType::World:
+        {
+            TArray<AActor*> Actors = Input.Actors;
+            Actors.RemoveAll([](AActor* Actor) { return !Actor; });
+            HashActors(Hasher, Actors);
+            break;
+        }
+        case EMythicaInputType::Spline:
+        {
+            const USplineComponent* SplineComponent = Input.SplineActor ? Input.SplineActor->FindComponentByClass<USplineComponent>() : nullptr;
+            if (!SplineComponent)
+            {
+                HashValue(Hasher, 0);
+                break;
+            }
+
+            int NumPoints = SplineComponent->GetNumberOfSplinePoints();
+            HashValue(Hasher, NumPoints);
+            for (int i = 0; i < NumPoints; ++i)
+            {
+                HashValue(Hasher, SplineComponent->GetLocationAtSplinePoint(i, ESplineCoordinateSpace::World));
+            }
+            break;
+        }
+        case EMythicaInputType::Volume:
+        {
+            if (!Input.VolumeActor)
+            {
+                HashValue(Hasher, 0);
+                break;
+            }
+
+            TArray<AActor*> Actors;
+            Input.VolumeActor->GetActors(Actors);
+
+            HashTransform(Hasher, Input.VolumeActor->GetActorTransform());
+            HashActors(Hasher, Actors);
+            break;
+        }
+    }
+
+    return FIoHash(Hasher.Finalize());
+}
+
+FIoHash Mythica::ComputeJobFingerprint(const FString& JobDefId, const FMythicaParameters& Params, const FVector& Origin)
+{
+    FBlake3 Hasher;
+    HashString(Hasher, JobDefId);
+
+    for (const FMythicaParameter& Param : Params.Parameters)
+    {
+        HashString(Hasher, Param.Name);
+        HashValue(Hasher, Param.Type);
+
+        switch (Param.Type)
+        {
+            case EMythicaParameterType::Int:
+                HashArray(Hasher, Param.ValueInt.Values);
+                break;
+
+            case EMythicaParameterType::Float:
+                HashArray(Hasher, Param.ValueFloat.Values);
+                break;
+
+            case EMythicaParameterType::Bool:
+                HashValue(Hasher, Param.ValueBool.Value);
+                break;
+
+            case EMythicaParameterType::String:
+                HashString(Hasher, Param.ValueString.Value);
+                break;
+
+            case EMythicaParameterType::Enum:
+                HashString(Hasher, Param.ValueEnum.Value);
+                break;
+
+            case EMythicaParameterType::File:
+                HashValue(Hasher, Mythica::ComputeInputFingerprint(Param.ValueFile, Origin));
+                break;
+        }
+    }
+
+    return FIoHash(Hasher.Finalize());
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IO/IoHash.h"
+
+struct FMythicaParameterFile;
+struct FMythicaParameters;
+class UStaticMesh;
+
+namespace Mythica
+{
+    /**
+     * Hash of everything that affects the result of a job: the job definition, every parameter value and
+     * the state of the meshes / actors referenced by file inputs. Two jobs with the same fingerprint are
+     * expected to produce the same result.
+     */
+    FIoHash ComputeJobFingerprint(const FString& JobDefId, const FMythicaParameters& Params, const FVector& Origin);
+
+    /** Hash of the state of a single file input as it would be exported for a job at the given origin */
+    FIoHash ComputeInputFingerprint(const FMythicaParameterFile& Input, const FVector& Origin);
+
+    /** Key that changes whenever the source data or build settings of the mesh change */
+    FString GetStaticMeshContentKey(const UStaticMesh* Mesh);
+
+    /** Key that changes whenever the material slots or their assigned materials of the mesh change */
+    FString GetStaticMeshMaterialKey(const UStaticMesh* Mesh);
+}
@@ -2,5 +2,205 @@
 
 
 #include "Jobs/MythicaJobSubsystem.h"
+
+#include "Kismet/KismetSystemLibrary.h"
+#include "MythicaComponent.h"
+#include "MythicaDeveloperSettings.h"
+#include "MythicaEditorSubsystem.h"
+
 #include "MythicaEditorPrivatePCH.h"
 
+#include UE_INLINE_GENERATED_CPP_BY_NAME(MythicaJobSubsystem)
+
+// Priority added to jobs of components on selected actors
+const int32 SelectedActorPriorityBoost = 100;
+
+void UMythicaJobSubsystem::EnqueueJob(int RequestId, UMythicaComponent* Component, int32 Priority)
+{
+    FMythicaJobRecord& Record = Queue.AddDefaulted_GetRef();
+    Record.RequestId = RequestId;
+    Record.OwningComponent = Component;
+    Record.OwningComponentName = IsValid(Component) ? UKismetSystemLibrary::GetDisplayName(Component) : FString();
+    Record.Priority = Priority;
+    Record.QueueTime = FDateTime::Now();
+
+    NotifyQueueChanged();
+
+    // Start on the next tick so the caller can bind to job state changes first
+    ScheduleDispatch();
+}
+
+void UMythicaJobSubsystem::OnJobFinished(int RequestId)
+{
+    int32 NumRemoved = InFlightJobs.Remove(RequestId);
+    NumRemoved += Queue.RemoveAll([RequestId](const FMythicaJobRecord& Record) { return Record.RequestId == RequestId; });
+
+    if (NumRemoved > 0)
+    {
+        NotifyQueueChanged();
+        ScheduleDispatch();
+    }
+}
+
+void UMythicaJobSubsystem::Reset()
+{
+    Queue.Reset();
+    InFlightJobs.Reset();
+
+    if (GEditor)
+    {
+        GEditor->GetTimerManager()->ClearTimer(DispatchTimer);
+    }
+
+    NotifyQueueChanged();
+}
+
+int32 UMythicaJobSubsystem::GetQueuePosition(int RequestId) const
+{
+    const FMythicaJobRecord* Target = Queue.FindByPredicate([RequestId](const FMythicaJobRecord& Record) { return Record.RequestId == RequestId; });
+    if (!Target)
+    {
+        return -1;
+    }
+
+    // Replay the dispatch order, every job that starts takes a slot from its component
+    TArray<const FMythicaJobRecord*> Candidates;
+    for (const FMythicaJobRecord& Record : Queue)
+    {
+        Candidates.Add(&Record);
+    }
+
+    TMap<FString, int32> InFlightPerComponent = CountInFlightPerComponent();
+
+    int32 Position = 0;
+    while (!Candidates.IsEmpty())
+    {
+        int32 Index = SelectNextJob(Candidates, InFlightPerComponent);
+        if (Candidates[Index] == Target)
+        {
+            break;
+        }
+
+        InFlightPerComponent.FindOrAdd(Candidates[Index]->OwningComponentName)++;
+        Candidates.RemoveAt(Index);
+        Position++;
+    }
+    return Position;
+}
+
+void UMythicaJobSubsystem::ScheduleDispatch()
+{
+    if (!GEditor || GEditor->GetTimerManager()->TimerExists(DispatchTimer))
+    {
+        return;
+    }
+
+    DispatchTimer = GEditor->GetTimerManager()->SetTimerForNextTick(FTimerDelegate::CreateUObject(this, &UMythicaJobSubsystem::DispatchJobs));
+}
+
+void UMythicaJobSubsystem::DispatchJobs()
+{
+    DispatchTimer.Invalidate();
+
+    UMythicaEditorSubsystem* MythicaEditorSubsystem = GEditor->GetEditorSubsystem<UMythicaEditorSubsystem>();
+
+    const UMythicaDeveloperSettings* Settings = GetDefault<UMythicaDeveloperSettings>();
+    int32 MaxInFlightJobs = FMath::Max(Settings->MaxConcurrentJobs, 1);
+
+    bool Changed = false;
+    while (InFlightJobs.Num() < MaxInFlightJobs && !Queue.IsEmpty())
+    {
+        int32 Index = SelectNextJob();
+        FMythicaJobRecord Record = Queue[Index];
+        Queue.RemoveAt(Index);
+
+        InFlightJobs.Add(Record.RequestId, Record);
+        Changed = true;
+
+        // Starting the job may finish it right away and release the slot again
+        MythicaEditorSubsystem->StartJob(Record.RequestId);
+    }
+
+    if (Changed)
+    {
+        NotifyQueueChanged();
+    }
+}
+
+int32 UMythicaJobSubsystem::SelectNextJob() const
+{
+    TArray<const FMythicaJobRecord*> Candidates;
+    for (const FMythicaJobRecord& Record : Queue)
+    {
+        Candidates.Add(&Record);
+    }
+
+    return SelectNextJob(Candidates, CountInFlightPerComponent());
+}
+
+TMap<FString, int32> UMythicaJobSubsystem::CountInFlightPerComponent() const
+{
+    // Counted per component so that one component can't take every slot
+    TMap<FString, int32> InFlightPerComponent;
+    for (const TPair<int, FMythicaJobRecord>& Pair : InFlightJobs)
+    {
+        InFlightPerComponent.FindOrAdd(Pair.Value.OwningComponentName)++;
+    }
+    return InFlightPerComponent;
+}
+
+int32 UMythicaJobSubsystem::SelectNextJob(const TArray<const FMythicaJobRecord*>& Candidates, const TMap<FString, int32>& InFlightPerComponent) const
+{
+    int32 BestIndex = 0;
+    int32 BestPriority = MIN_int32;
+    int32 BestInFlight = MAX_int32;
+    for (int32 i = 0; i < Candidates.Num(); ++i)
+    {
+        const FMythicaJobRecord& Record = *Candidates[i];
+
+        int32 Priority = GetEffectivePriority(Record);
+        const int32* InFlightPtr = InFlightPerComponent.Find(Record.OwningComponentName);
+        int32 InFlight = InFlightPtr ? *InFlightPtr : 0;
+
+        // Queue is in arrival order so the first of equal candidates is the oldest
+        if (Priority > BestPriority || (Priority == BestPriority && InFlight < BestInFlight))
+        {
+            BestIndex = i;
+            BestPriority = Priority;
+            BestInFlight = InFlight;
+        }
+    }
+
+    return BestIndex;
+}
+
+int32 UMythicaJobSubsystem::GetEffectivePriority(const FMythicaJobRecord& Record) const
+{
+    int32 Priority = Record.Priority;
+
+    UMythicaComponent* Component = Record.OwningComponent.Get();
+    if (Component && Component->GetOwner() && Component->GetOwner()->IsSelected())
+    {
+        Priority += SelectedActorPriorityBoost;
+    }
+
+    return Priority;
+}
+
+void UMythicaJobSubsystem::NotifyQueueChanged()
+{
+    OnJobQueueChanged.Broadcast(Queue.Num(), InFlightJobs.Num());
+
+    const UMythicaDeveloperSettings* Settings = GetDefault<UMythicaDeveloperSettings>();
+    bool NewSaturated = Queue.Num() >= Settings->JobQueueSaturationThreshold;
+    if (NewSaturated != Saturated)
+    {
+        Saturated = NewSaturated;
+        OnJobQueueSaturationChanged.Broadcast(Saturated);
+
+        if (Saturated)
+        {
+            UE_LOG(LogMythica, Warning, TEXT("Job queue is saturated, %d jobs waiting for %d in flight"), Queue.Num(), InFlightJobs.Num());
+        }
+    }
+}
@@ -3,15 +3,75 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Engine/TimerHandle.h"
+#include "Jobs/MythicaJob.h"
 #include "Subsystems/EngineSubsystem.h"
 #include "MythicaJobSubsystem.generated.h"
 
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnJobQueueChanged, int32, NumQueued, int32, NumInFlight);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnJobQueueSaturationChanged, bool, Saturated);
+
 /**
- * 
+ * Mythica Job Subsystem
+ *
+ * Schedules the jobs created by the editor subsystem. Only a bounded number of jobs are exported, uploaded
+ * and processed at once, the rest wait in a queue. Jobs of the selected actors are started first and the
+ * remaining slots are shared between the components waiting in the queue.
  */
 UCLASS()
 class UMythicaJobSubsystem : public UEngineSubsystem
 {
-	GENERATED_BODY()
-	
+    GENERATED_BODY()
+
+public:
+
+    /** Queue a job created by the editor subsystem, it is started once a slot frees up */
+    void EnqueueJob(int RequestId, class UMythicaComponent* Component, int32 Priority = 0);
+
+    /** Release the slot or queue entry of a job that reached a final state */
+    void OnJobFinished(int RequestId);
+
+    /** Forget all queued and in flight jobs */
+    void Reset();
+
+    UFUNCTION(BlueprintPure, Category = "Mythica")
+    int32 GetNumQueuedJobs() const { return Queue.Num(); }
+
+    UFUNCTION(BlueprintPure, Category = "Mythica")
+    int32 GetNumInFlightJobs() const { return InFlightJobs.Num(); }
+
+    /** Number of jobs that will start before the job in dispatch order, -1 if the job is not queued */
+    UFUNCTION(BlueprintPure, Category = "Mythica")
+    int32 GetQueuePosition(int RequestId) const;
+
+    /** True while the queue is longer than the configured back-pressure threshold */
+    UFUNCTION(BlueprintPure, Category = "Mythica")
+    bool IsSaturated() const { return Saturated; }
+
+    UPROPERTY(BlueprintAssignable, Category = "Mythica")
+    FOnJobQueueChanged OnJobQueueChanged;
+
+    UPROPERTY(BlueprintAssignable, Category = "Mythica")
+    FOnJobQueueSaturationChanged OnJobQueueSaturationChanged;
+
+private:
+
+    void ScheduleDispatch();
+    void DispatchJobs();
+    int32 SelectNextJob() const;
+
+    /** Index of the job in Candidates that starts next given the in flight jobs per component, both the dispatch and the queue position use it */
+    int32 SelectNextJob(const TArray<const FMythicaJobRecord*>& Candidates, const TMap<FString, int32>& InFlightPerComponent) const;
+    TMap<FString, int32> CountInFlightPerComponent() const;
+    int32 GetEffectivePriority(const FMythicaJobRecord& Record) const;
+    void NotifyQueueChanged();
+
+    UPROPERTY()
+    TArray<FMythicaJobRecord> Queue;
+
+    UPROPERTY()
+    TMap<int, FMythicaJobRecord> InFlightJobs;
+
+    FTimerHandle DispatchTimer;
+    bool Saturated = false;
 };
@@ -0,0 +1,253 @@
+#include "Jobs/MythicaResultCache.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+#include "MythicaEditorPrivatePCH.h"
+
+const TCHAR* ResultCacheIndexFile = TEXT("Index.json");
+
+void FMythicaResultCache::Initialize()
+{
+    CacheDirectory = FPaths::Combine(FPaths::ProjectIntermediateDir(), TEXT("MythicaCache"), TEXT("ResultCache"));
+    LoadIndex();
+}
+
+void FMythicaResultCache::Deinitialize()
+{
+    if (bIndexDirty)
+    {
+        SaveIndex();
+    }
+}
+
+bool FMythicaResultCache::FindResultFile(const FString& Fingerprint, FString& OutFilePath)
+{
+    FMythicaResultCacheEntry* Entry = Entries.Find(Fingerprint);
+    if (!Entry || Entry->FileName.IsEmpty())
+    {
+        return false;
+    }
+
+    FString FilePath = FPaths::Combine(CacheDirectory, Entry->FileName);
+    if (!FPaths::FileExists(FilePath))
+    {
+        RemoveEntry(Fingerprint);
+        bIndexDirty = true;
+        return false;
+    }
+
+    Entry->LastAccessTime = FDateTime::UtcNow();
+    bIndexDirty = true;
+
+    OutFilePath = FilePath;
+    return true;
+}
+
+bool FMythicaResultCache::FindImportDirectory(const FString& Fingerprint, FString& OutImportDirectory)
+{
+    FMythicaResultCacheEntry* Entry = Entries.Find(Fingerprint);
+    if (!Entry || Entry->ImportDirectory.IsEmpty())
+    {
+        return false;
+    }
+
+    FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
+    if (!AssetRegistryModule.Get().HasAssets(*Entry->ImportDirectory, true))
+    {
+        Entry->ImportDirectory.Empty();
+        bIndexDirty = true;
+        return false;
+    }
+
+    Entry->LastAccessTime = FDateTime::UtcNow();
+    bIndexDirty = true;
+
+    OutImportDirectory = Entry->ImportDirectory;
+    return true;
+}
+
+bool FMythicaResultCache::AddResult(const FString& Fingerprint, const TArray<uint8>& FileData)
+{
+    FString FileName = Fingerprint + TEXT(".usdz");
+    FString FilePath = FPaths::Combine(CacheDirectory, FileName);
+
+    if (!FFileHelper::SaveArrayToFile(FileData, *FilePath))
+    {
+        UE_LOG(LogMythicaEditor, Warning, TEXT("Failed to write result cache file %s"), *FilePath);
+        return false;
+    }
+
+    FMythicaResultCacheEntry& Entry = Entries.FindOrAdd(Fingerprint);
+    Entry.FileName = FileName;
+    Entry.Size = FileData.Num();
+    Entry.LastAccessTime = FDateTime::UtcNow();
+
+    SaveIndex();
+    return true;
+}
+
+void FMythicaResultCache::SetImportDirectory(const FString& Fingerprint, const FString& ImportDirectory)
+{
+    // Importing over a directory invalidates whatever result it previously held
+    for (TPair<FString, FMythicaResultCacheEntry>& Pair : Entries)
+    {
+        if (Pair.Value.ImportDirectory == ImportDirectory)
+        {
+            Pair.Value.ImportDirectory.Empty();
+        }
+    }
+
+    FMythicaResultCacheEntry& Entry = Entries.FindOrAdd(Fingerprint);
+    Entry.ImportDirectory = ImportDirectory;
+    Entry.LastAccessTime = FDateTime::UtcNow();
+
+    SaveIndex();
+}
+
+void FMythicaResultCache::Trim(int64 MaxSizeBytes)
+{
+    int64 TotalSize = GetTotalSize();
+    if (TotalSize <= MaxSizeBytes)
+    {
+        return;
+    }
+
+    TArray<FString> Fingerprints;
+    Entries.GetKeys(Fingerprints);
+    Fingerprints.Sort([this](const FString& A, const FString& B)
+    {
+        return Entries[A].LastAccessTime < Entries[B].LastAccessTime;
+    });
+
+    for (const FString& Fingerprint : Fingerprints)
+    {
+        if (TotalSize <= MaxSizeBytes)
+        {
+            break;
+        }
+
+        FMythicaResultCacheEntry& Entry = Entries[Fingerprint];
+        if (Entry.FileName.IsEmpty())
+        {
+            continue;
+        }
+
+        TotalSize -= Entry.Size;
+        IFileManager::Get().Delete(*FPaths::Combine(CacheDirectory, Entry.FileName));
+
+        // Keep track of the import so it can still be reused while it exists
+        Entry.FileName.Empty();
+        Entry.Size = 0;
+        if (Entry.ImportDirectory.IsEmpty())
+        {
+            Entries.Remove(Fingerprint);
+        }
+    }
+
+    SaveIndex();
+}
+
+int64 FMythicaResultCache::GetTotalSize() const
+{
+    int64 TotalSize = 0;
+    for (const TPair<FString, FMythicaResultCacheEntry>& Pair : Entries)
+    {
+        TotalSize += Pair.Value.Size;
+    }
+    return TotalSize;
+}
+
+void FMythicaResultCache::LoadIndex()
+{
+    Entries.Reset();
+
+    FString IndexPath = FPaths::Combine(CacheDirectory, ResultCacheIndexFile);
+
+    FString IndexContent;
+    if (!FFileHelper::LoadFileToString(IndexContent, *IndexPath))
+    {
+        return;
+    }
+
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(IndexContent);
+
+    TSharedPtr<FJsonObject> JsonObject;
+    if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
+    {
+        UE_LOG(LogMythicaEditor, Warning, TEXT("Failed to parse result cache index %s"), *IndexPath);
+        return;
+    }
+
+    const TArray<TSharedPtr<FJsonValue>>* EntryArray = nullptr;
+    if (!JsonObject->TryGetArrayField(TEXT("entries"), EntryArray))
+    {
+        return;
+    }
+
+    for (const TSharedPtr<FJsonValue>& Value : *EntryArray)
+    {
+        TSharedPtr<FJsonObject> EntryObject = Value->AsObject();
+        if (!EntryObject.IsValid())
+        {
+            continue;
+        }
+
+        FString Fingerprint = EntryObject->GetStringField(TEXT("fingerprint"));
+        if (Fingerprint.IsEmpty())
+        {
+            continue;
+        }
+
+        FMythicaResultCacheEntry Entry;
+        Entry.FileName = EntryObject->GetStringField(TEXT("file_name"));
+        Entry.ImportDirectory = EntryObject->GetStringField(TEXT("import_directory"));
+        Entry.Size = (int64)EntryObject->GetNumberField(TEXT("size"));
+        FDateTime::ParseIso8601(*EntryObject->GetStringField(TEXT("last_access_time")), Entry.LastAccessTime);
+
+        Entries.Add(Fingerprint, Entry);
+    }
+}
+
+void FMythicaResultCache::SaveIndex()
+{
+    bIndexDirty = false;
+
+    TArray<TSharedPtr<FJsonValue>> EntryArray;
+    for (const TPair<FString, FMythicaResultCacheEntry>& Pair : Entries)
+    {
+        TSharedPtr<FJsonObject> EntryObject = MakeShareable(new FJsonObject);
+        EntryObject->SetStringField(TEXT("fingerprint"), Pair.Key);
+        EntryObject->SetStringField(TEXT("file_name"), Pair.Value.FileName);
+        EntryObject->SetStringField(TEXT("import_directory"), Pair.Value.ImportDirectory);
+        EntryObject->SetNumberField(TEXT("size"), Pair.Value.Size);
+        EntryObject->SetStringField(TEXT("last_access_time"), Pair.Value.LastAccessTime.ToIso8601());
+
+        EntryArray.Add(MakeShareable(new FJsonValueObject(EntryObject)));
+    }
+
+    TSharedPtr<FJsonObject> JsonObject = MakeShareable(new FJsonObject);
+    JsonObject->SetArrayField(TEXT("entries"), EntryArray);
+
+    FString IndexContent;
+    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&IndexContent);
+    FJsonSerializer::Serialize(JsonObject.ToSharedRef(), Writer);
+
+    FString IndexPath = FPaths::Combine(CacheDirectory, ResultCacheIndexFile);
+    FFileHelper::SaveStringToFile(IndexContent, *IndexPath);
+}
+
+void FMythicaResultCache::RemoveEntry(const FString& Fingerprint)
+{
+    FMythicaResultCacheEntry Entry;
+    if (Entries.RemoveAndCopyValue(Fingerprint, Entry) && !Entry.FileName.IsEmpty())
+    {
+        IFileManager::Get().Delete(*FPaths::Combine(CacheDirectory, Entry.FileName));
+    }
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FMythicaResultCacheEntry
+{
+    /** Name of the cached result file inside the cache directory */
+    FString FileName;
+
+    /** Size of the cached result file in bytes */
+    int64 Size = 0;
+
+    /** Last time the entry was read or written, used for LRU eviction */
+    FDateTime LastAccessTime;
+
+    /** Content directory currently holding an import of this result, if any */
+    FString ImportDirectory;
+};
+
+/**
+ * FMythicaResultCache
+ *
+ * Content addressed cache of job result files stored under Intermediate/MythicaCache/ResultCache.
+ * Entries are keyed by the job fingerprint and evicted least recently used first once the cache
+ * grows past its size budget.
+ */
+class FMythicaResultCache
+{
+public:
+
+    void Initialize();
+    void Deinitialize();
+
+    /** Returns the path of the cached result file for the fingerprint */
+    bool FindResultFile(const FString& Fingerprint, FString& OutFilePath);
+
+    /** Returns the content directory that holds a valid import of the fingerprint */
+    bool FindImportDirectory(const FString& Fingerprint, FString& OutImportDirectory);
+
+    bool AddResult(const FString& Fingerprint, const TArray<uint8>& FileData);
+    void SetImportDirectory(const FString& Fingerprint, const FString& ImportDirectory);
+
+    void Trim(int64 MaxSizeBytes);
+    int64 GetTotalSize() const;
+
+private:
+
+    void LoadIndex();
+    void SaveIndex();
+    void RemoveEntry(const FString& Fingerprint);
+
+    FString CacheDirectory;
+    TMap<FString, FMythicaResultCacheEntry> Entries;
+
+    /** Lookups only touch access times in memory, the index is written when entries change or on shutdown */
+    bool bIndexDirty = false;
+};
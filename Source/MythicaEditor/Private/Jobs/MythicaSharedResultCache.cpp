@@ -0,0 +1,84 @@
+#include "Jobs/MythicaSharedResultCache.h"
+
+#include "Async/Async.h"
+#include "DerivedDataCache.h"
+#include "DerivedDataCacheKey.h"
+#include "DerivedDataRequestOwner.h"
+#include "DerivedDataValue.h"
+#include "IO/IoHash.h"
+
+#include "MythicaEditorPrivatePCH.h"
+
+using namespace UE::DerivedData;
+
+static const FCacheBucket MythicaResultBucket(TEXT("MythicaResult"));
+
+static bool MakeCacheKey(const FString& Fingerprint, FCacheKey& OutKey)
+{
+    FIoHash Hash;
+    if (Fingerprint.Len() != 40 || !LexFromString(Hash, *Fingerprint))
+    {
+        return false;
+    }
+
+    OutKey = { MythicaResultBucket, Hash };
+    return true;
+}
+
+void FMythicaSharedResultCache::Get(const FString& Fingerprint, FOnGetComplete OnComplete)
+{
+    FCacheKey Key;
+    if (!MakeCacheKey(Fingerprint, Key))
+    {
+        OnComplete.ExecuteIfBound(false, TArray<uint8>());
+        return;
+    }
+
+    FCacheGetValueRequest Request;
+    Request.Name = FString::Printf(TEXT("MythicaResult/%s"), *Fingerprint);
+    Request.Key = Key;
+    Request.Policy = ECachePolicy::Default;
+
+    FRequestOwner Owner(EPriority::Normal);
+    GetCache().GetValue({ Request }, Owner, [OnComplete](FCacheGetValueResponse&& Response)
+    {
+        TArray<uint8> FileData;
+        bool bHit = Response.Status == EStatus::Ok;
+        if (bHit)
+        {
+            FSharedBuffer Buffer = Response.Value.GetData().Decompress();
+            FileData.Append((const uint8*)Buffer.GetData(), Buffer.GetSize());
+        }
+
+        AsyncTask(ENamedThreads::GameThread, [OnComplete, bHit, FileData = MoveTemp(FileData)]()
+        {
+            OnComplete.ExecuteIfBound(bHit, FileData);
+        });
+    });
+    Owner.KeepAlive();
+}
+
+void FMythicaSharedResultCache::Put(const FString& Fingerprint, const TArray<uint8>& FileData)
+{
+    FCacheKey Key;
+    if (!MakeCacheKey(Fingerprint, Key))
+    {
+        return;
+    }
+
+    FCachePutValueRequest Request;
+    Request.Name = FString::Printf(TEXT("MythicaResult/%s"), *Fingerprint);
+    Request.Key = Key;
+    Request.Value = FValue::Compress(FSharedBuffer::Clone(FileData.GetData(), FileData.Num()));
+    Request.Policy = ECachePolicy::Default;
+
+    FRequestOwner Owner(EPriority::Low);
+    GetCache().PutValue({ Request }, Owner, [Fingerprint](FCachePutValueResponse&& Response)
+    {
+        if (Response.Status != EStatus::Ok)
+        {
+            UE_LOG(LogMythicaEditor, Warning, TEXT("Failed to store result %s in the derived data cache"), *Fingerprint);
+        }
+    });
+    Owner.KeepAlive();
+}
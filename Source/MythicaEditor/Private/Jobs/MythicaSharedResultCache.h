@@ -0,0 +1,20 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * FMythicaSharedResultCache
+ *
+ * Stores job result files in the derived data cache under the MythicaResult bucket so that a result
+ * generated on one machine can be pulled by every editor sharing the same DDC (shared filesystem or cloud).
+ * Requests are asynchronous and their callbacks are invoked on the game thread.
+ */
+class FMythicaSharedResultCache
+{
+public:
+
+    DECLARE_DELEGATE_TwoParams(FOnGetComplete, bool /* bHit */, const TArray<uint8>& /* FileData */);
+
+    static void Get(const FString& Fingerprint, FOnGetComplete OnComplete);
+    static void Put(const FString& Fingerprint, const TArray<uint8>& FileData);
+};
@@ -0,0 +1,166 @@
+#include "Jobs/MythicaUploadCache.h"
+
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "IO/IoHash.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+#include "MythicaEditorPrivatePCH.h"
+
+const TCHAR* UploadCacheIndexFile = TEXT("Index.json");
+
+void FMythicaUploadCache::Initialize()
+{
+    CacheDirectory = FPaths::Combine(FPaths::ProjectIntermediateDir(), TEXT("MythicaCache"), TEXT("UploadCache"));
+    LoadIndex();
+}
+
+bool FMythicaUploadCache::FindFileId(const FString& Key, const FString& ServiceURL, double ExpirySeconds, FString& OutFileId)
+{
+    FMythicaUploadCacheEntry* Entry = Entries.Find(Key);
+    if (!Entry || Entry->ServiceURL != ServiceURL)
+    {
+        return false;
+    }
+
+    if ((FDateTime::UtcNow() - Entry->UploadTime).GetTotalSeconds() > ExpirySeconds)
+    {
+        Entries.Remove(Key);
+        SaveIndex();
+        return false;
+    }
+
+    OutFileId = Entry->FileId;
+    return true;
+}
+
+void FMythicaUploadCache::AddFileId(const FString& Key, const FString& ServiceURL, const FString& FileId)
+{
+    FMythicaUploadCacheEntry& Entry = Entries.FindOrAdd(Key);
+    Entry.FileId = FileId;
+    Entry.ServiceURL = ServiceURL;
+    Entry.UploadTime = FDateTime::UtcNow();
+
+    SaveIndex();
+}
+
+void FMythicaUploadCache::RemoveFileIds(const TArray<FString>& FileIds)
+{
+    int32 NumRemoved = 0;
+    for (auto It = Entries.CreateIterator(); It; ++It)
+    {
+        if (FileIds.Contains(It.Value().FileId))
+        {
+            It.RemoveCurrent();
+            NumRemoved++;
+        }
+    }
+
+    if (NumRemoved > 0)
+    {
+        SaveIndex();
+    }
+}
+
+void FMythicaUploadCache::Trim(double ExpirySeconds)
+{
+    FDateTime Now = FDateTime::UtcNow();
+
+    int32 NumRemoved = 0;
+    for (auto It = Entries.CreateIterator(); It; ++It)
+    {
+        if ((Now - It.Value().UploadTime).GetTotalSeconds() > ExpirySeconds)
+        {
+            It.RemoveCurrent();
+            NumRemoved++;
+        }
+    }
+
+    if (NumRemoved > 0)
+    {
+        SaveIndex();
+    }
+}
+
+FString FMythicaUploadCache::HashData(const TArray64<uint8>& Data)
+{
+    return LexToString(FIoHash::HashBuffer(Data.GetData(), Data.Num()));
+}
+
+void FMythicaUploadCache::LoadIndex()
+{
+    Entries.Reset();
+
+    FString IndexPath = FPaths::Combine(CacheDirectory, UploadCacheIndexFile);
+
+    FString IndexContent;
+    if (!FFileHelper::LoadFileToString(IndexContent, *IndexPath))
+    {
+        return;
+    }
+
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(IndexContent);
+
+    TSharedPtr<FJsonObject> JsonObject;
+    if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
+    {
+        UE_LOG(LogMythicaEditor, Warning, TEXT("Failed to parse upload cache index %s"), *IndexPath);
+        return;
+    }
+
+    const TArray<TSharedPtr<FJsonValue>>* EntryArray = nullptr;
+    if (!JsonObject->TryGetArrayField(TEXT("entries"), EntryArray))
+    {
+        return;
+    }
+
+    for (const TSharedPtr<FJsonValue>& Value : *EntryArray)
+    {
+        TSharedPtr<FJsonObject> EntryObject = Value->AsObject();
+        if (!EntryObject.IsValid())
+        {
+            continue;
+        }
+
+        FString Key = EntryObject->GetStringField(TEXT("key"));
+        if (Key.IsEmpty())
+        {
+            continue;
+        }
+
+        FMythicaUploadCacheEntry Entry;
+        Entry.FileId = EntryObject->GetStringField(TEXT("file_id"));
+        Entry.ServiceURL = EntryObject->GetStringField(TEXT("service_url"));
+        FDateTime::ParseIso8601(*EntryObject->GetStringField(TEXT("upload_time")), Entry.UploadTime);
+
+        Entries.Add(Key, Entry);
+    }
+}
+
+void FMythicaUploadCache::SaveIndex() const
+{
+    TArray<TSharedPtr<FJsonValue>> EntryArray;
+    for (const TPair<FString, FMythicaUploadCacheEntry>& Pair : Entries)
+    {
+        TSharedPtr<FJsonObject> EntryObject = MakeShareable(new FJsonObject);
+        EntryObject->SetStringField(TEXT("key"), Pair.Key);
+        EntryObject->SetStringField(TEXT("file_id"), Pair.Value.FileId);
+        EntryObject->SetStringField(TEXT("service_url"), Pair.Value.ServiceURL);
+        EntryObject->SetStringField(TEXT("upload_time"), Pair.Value.UploadTime.ToIso8601());
+
+        EntryArray.Add(MakeShareable(new FJsonValueObject(EntryObject)));
+    }
+
+    TSharedPtr<FJsonObject> JsonObject = MakeShareable(new FJsonObject);
+    JsonObject->SetArrayField(TEXT("entries"), EntryArray);
+
+    FString IndexContent;
+    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&IndexContent);
+    FJsonSerializer::Serialize(JsonObject.ToSharedRef(), Writer);
+
+    FString IndexPath = FPaths::Combine(CacheDirectory, UploadCacheIndexFile);
+    FFileHelper::SaveStringToFile(IndexContent, *IndexPath);
+}
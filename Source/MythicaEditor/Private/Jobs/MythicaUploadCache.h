@@ -0,0 +1,51 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FMythicaUploadCacheEntry
+{
+    /** Id of the uploaded file on the server */
+    FString FileId;
+
+    /** Service the file was uploaded to, file ids are only valid on that service */
+    FString ServiceURL;
+
+    /** Time of the upload, the server only keeps uploaded files for a limited time */
+    FDateTime UploadTime;
+};
+
+/**
+ * FMythicaUploadCache
+ *
+ * Maps job inputs to the ids of files already uploaded to the server, stored under
+ * Intermediate/MythicaCache/UploadCache. Entries are keyed by the input fingerprint, which lets an
+ * unchanged input skip both the export and the upload, and by the hash of the exported file, which
+ * catches different inputs that export to identical files. Entries expire after a fixed time since
+ * the upload so file ids the server may have cleaned up are not reused.
+ */
+class FMythicaUploadCache
+{
+public:
+
+    void Initialize();
+
+    bool FindFileId(const FString& Key, const FString& ServiceURL, double ExpirySeconds, FString& OutFileId);
+    void AddFileId(const FString& Key, const FString& ServiceURL, const FString& FileId);
+
+    /** Drops every entry pointing at the files, used when the server rejects them */
+    void RemoveFileIds(const TArray<FString>& FileIds);
+
+    /** Removes expired entries */
+    void Trim(double ExpirySeconds);
+
+    /** Key of an exported input's contents */
+    static FString HashData(const TArray64<uint8>& Data);
+
+private:
+
+    void LoadIndex();
+    void SaveIndex() const;
+
+    FString CacheDirectory;
+    TMap<FString, FMythicaUploadCacheEntry> Entries;
+};
@@ -0,0 +1,68 @@
+#include "Jobs/MythicaUploadCompression.h"
+
+THIRD_PARTY_INCLUDES_START
+#include "zlib.h"
+THIRD_PARTY_INCLUDES_END
+
+#include "MythicaEditorPrivatePCH.h"
+
+const TCHAR* Mythica::UploadContentEncoding = TEXT("gzip");
+
+static constexpr int64 GzipChunkSize = 1024 * 1024;
+
+// Window bits of 15 plus 16 makes deflate write a gzip header and trailer
+static constexpr int GzipWindowBits = 15 + 16;
+
+bool Mythica::GzipData(const TArray64<uint8>& Source, int32 Level, TArray64<uint8>& OutCompressed)
+{
+    OutCompressed.Reset();
+
+    z_stream Stream;
+    FMemory::Memzero(Stream);
+    if (deflateInit2(&Stream, FMath::Clamp(Level, 1, 9), Z_DEFLATED, GzipWindowBits, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+    {
+        UE_LOG(LogMythicaEditor, Error, TEXT("Failed to initialize gzip compression"));
+        return false;
+    }
+
+    // zlib counts in 32 bits, so the data is fed and drained in chunks
+    int64 Offset = 0;
+    bool Success = true;
+
+    int Flush = Z_NO_FLUSH;
+    while (Success && Flush != Z_FINISH)
+    {
+        int64 ReadSize = FMath::Min(GzipChunkSize, Source.Num() - Offset);
+        Stream.next_in = (Bytef*)Source.GetData() + Offset;
+        Stream.avail_in = (uInt)ReadSize;
+        Offset += ReadSize;
+        Flush = Offset >= Source.Num() ? Z_FINISH : Z_NO_FLUSH;
+
+        do
+        {
+            int64 OutOffset = OutCompressed.Num();
+            OutCompressed.AddUninitialized(GzipChunkSize);
+            Stream.next_out = OutCompressed.GetData() + OutOffset;
+            Stream.avail_out = (uInt)GzipChunkSize;
+
+            if (deflate(&Stream, Flush) == Z_STREAM_ERROR)
+            {
+                UE_LOG(LogMythicaEditor, Error, TEXT("Failed to compress upload data"));
+                Success = false;
+                break;
+            }
+
+            OutCompressed.SetNum(OutCompressed.Num() - Stream.avail_out, false);
+        }
+        while (Stream.avail_out == 0);
+    }
+
+    deflateEnd(&Stream);
+
+    if (!Success)
+    {
+        OutCompressed.Empty();
+    }
+
+    return Success;
+}
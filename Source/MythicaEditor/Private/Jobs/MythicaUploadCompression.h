@@ -0,0 +1,12 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace Mythica
+{
+    /** Value of the Content-Encoding header of compressed upload parts */
+    extern const TCHAR* UploadContentEncoding;
+
+    /** Gzip compresses data, Level ranges from 1 (fastest) to 9 (smallest). Safe to call from worker threads. */
+    bool GzipData(const TArray64<uint8>& Source, int32 Level, TArray64<uint8>& OutCompressed);
+}
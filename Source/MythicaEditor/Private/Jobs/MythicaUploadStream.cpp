@@ -0,0 +1,174 @@
+#include "Jobs/MythicaUploadStream.h"
+
+#include "MythicaEditorPrivatePCH.h"
+
+static const TCHAR* MultipartNewLine = TEXT("\r\n");
+
+FMythicaMultipartStream::FMythicaMultipartStream(const FString& InBoundary)
+    : Boundary(InBoundary)
+{
+    SetIsLoading(true);
+    SetIsPersistent(false);
+}
+
+FMythicaMultipartStream::~FMythicaMultipartStream()
+{
+    Close();
+}
+
+FString FMythicaMultipartStream::GetContentType() const
+{
+    return FString::Printf(TEXT("multipart/form-data; boundary=%s"), *Boundary);
+}
+
+void FMythicaMultipartStream::AddData(const FString& FieldName, const FMythicaUploadData& Data, const FString& FileName, const FString& ContentEncoding)
+{
+    check(!Finalized && Data.IsValid());
+
+    FString Header;
+    Header += TEXT("--") + Boundary + MultipartNewLine;
+    Header += FString::Printf(TEXT("Content-Disposition: form-data; name=\"%s\"; filename=\"%s\""), *FieldName, *FileName) + MultipartNewLine;
+    Header += FString(TEXT("Content-Type: application/octet-stream")) + MultipartNewLine;
+    if (!ContentEncoding.IsEmpty())
+    {
+        Header += FString::Printf(TEXT("Content-Encoding: %s"), *ContentEncoding) + MultipartNewLine;
+    }
+    Header += MultipartNewLine;
+    AddText(Header);
+
+    FSegment& Segment = Segments.AddDefaulted_GetRef();
+    Segment.Offset = Size;
+    Segment.Size = Data->Num();
+    Segment.Data = Data;
+    Size += Segment.Size;
+
+    AddText(MultipartNewLine);
+}
+
+void FMythicaMultipartStream::Finalize()
+{
+    if (!Finalized)
+    {
+        AddText(TEXT("--") + Boundary + TEXT("--") + MultipartNewLine);
+        Finalized = true;
+    }
+}
+
+void FMythicaMultipartStream::AddText(const FString& Text)
+{
+    FSegment& Segment = Segments.AddDefaulted_GetRef();
+    Segment.Offset = Size;
+    Segment.Size = FTCHARToUTF8(*Text, Text.Len()).Length();
+    Segment.Text = Text;
+    Size += Segment.Size;
+}
+
+void FMythicaMultipartStream::Serialize(void* Data, int64 Num)
+{
+    uint8* Dest = (uint8*)Data;
+    while (Num > 0)
+    {
+        int32 SegmentIndex = FindSegment(Position);
+        if (SegmentIndex == INDEX_NONE)
+        {
+            UE_LOG(LogMythicaEditor, Error, TEXT("Read past the end of the upload stream"));
+            SetError();
+            return;
+        }
+
+        int64 Read = ReadSegment(SegmentIndex, Position - Segments[SegmentIndex].Offset, Dest, Num);
+        if (Read <= 0)
+        {
+            SetError();
+            return;
+        }
+
+        Dest += Read;
+        Num -= Read;
+        Position += Read;
+    }
+}
+
+void FMythicaMultipartStream::Seek(int64 InPos)
+{
+    Position = FMath::Clamp<int64>(InPos, 0, Size);
+}
+
+bool FMythicaMultipartStream::Close()
+{
+    OpenText.Empty();
+    OpenSegment = INDEX_NONE;
+    return !IsError();
+}
+
+int32 FMythicaMultipartStream::FindSegment(int64 InPos) const
+{
+    // Reads are sequential, so the open segment or the one after it is almost always the match
+    int32 Start = OpenSegment != INDEX_NONE && Segments[OpenSegment].Offset <= InPos ? OpenSegment : 0;
+    for (int32 i = Start; i < Segments.Num(); ++i)
+    {
+        if (InPos >= Segments[i].Offset && InPos < Segments[i].Offset + Segments[i].Size)
+        {
+            return i;
+        }
+    }
+
+    return INDEX_NONE;
+}
+
+int64 FMythicaMultipartStream::ReadSegment(int32 SegmentIndex, int64 SegmentPos, uint8* Dest, int64 Num)
+{
+    const FSegment& Segment = Segments[SegmentIndex];
+    int64 ReadSize = FMath::Min(Num, Segment.Size - SegmentPos);
+
+    if (Segment.Data.IsValid())
+    {
+        FMemory::Memcpy(Dest, Segment.Data->GetData() + SegmentPos, ReadSize);
+        return ReadSize;
+    }
+
+    if (OpenSegment != SegmentIndex)
+    {
+        Close();
+        OpenSegment = SegmentIndex;
+
+        FTCHARToUTF8 Converted(*Segment.Text, Segment.Text.Len());
+        OpenText.Append(Converted.Get(), Converted.Length());
+    }
+
+    FMemory::Memcpy(Dest, OpenText.GetData() + SegmentPos, ReadSize);
+    return ReadSize;
+}
+
+FMythicaDataRangeStream::FMythicaDataRangeStream(const FMythicaUploadData& InData, int64 InOffset, int64 InSize)
+    : Data(InData)
+    , Offset(InOffset)
+    , Size(InSize)
+{
+    check(Data.IsValid() && Offset + Size <= Data->Num());
+    SetIsLoading(true);
+    SetIsPersistent(false);
+}
+
+void FMythicaDataRangeStream::Serialize(void* Dest, int64 Num)
+{
+    if (Position + Num > Size)
+    {
+        UE_LOG(LogMythicaEditor, Error, TEXT("Read past the end of the upload part"));
+        SetError();
+        return;
+    }
+
+    FMemory::Memcpy(Dest, Data->GetData() + Offset + Position, Num);
+    Position += Num;
+}
+
+void FMythicaDataRangeStream::Seek(int64 InPos)
+{
+    Position = FMath::Clamp<int64>(InPos, 0, Size);
+}
+
+bool FMythicaDataRangeStream::Close()
+{
+    return !IsError();
+}
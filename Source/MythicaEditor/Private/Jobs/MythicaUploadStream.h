@@ -0,0 +1,93 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Serialization/Archive.h"
+
+/** Exported input data, shared between the upload and the request bodies sending it */
+using FMythicaUploadData = TSharedPtr<const TArray64<uint8>, ESPMode::ThreadSafe>;
+
+/**
+ * FMythicaMultipartStream
+ *
+ * multipart/form-data request body that references the uploaded data instead of copying it into the
+ * request. Part headers are only formatted once the HTTP thread reaches them.
+ */
+class FMythicaMultipartStream : public FArchive
+{
+public:
+
+    explicit FMythicaMultipartStream(const FString& InBoundary);
+    virtual ~FMythicaMultipartStream();
+
+    /** Adds a file part, ContentEncoding is sent as the part's Content-Encoding header when the data is compressed */
+    void AddData(const FString& FieldName, const FMythicaUploadData& Data, const FString& FileName, const FString& ContentEncoding = FString());
+
+    /** Ends the body, no parts can be added afterwards */
+    void Finalize();
+
+    const FString& GetBoundary() const { return Boundary; }
+    FString GetContentType() const;
+
+    // FArchive interface
+    virtual void Serialize(void* Data, int64 Num) override;
+    virtual int64 Tell() override { return Position; }
+    virtual int64 TotalSize() override { return Size; }
+    virtual void Seek(int64 InPos) override;
+    virtual bool Close() override;
+    virtual FString GetArchiveName() const override { return TEXT("FMythicaMultipartStream"); }
+
+private:
+
+    struct FSegment
+    {
+        /** Offset of the segment in the body */
+        int64 Offset = 0;
+        int64 Size = 0;
+
+        /** A segment is either file data or a part header / delimiter */
+        FMythicaUploadData Data;
+        FString Text;
+    };
+
+    void AddText(const FString& Text);
+    int32 FindSegment(int64 InPos) const;
+
+    /** Reads from a segment, converting its text when it is first reached */
+    int64 ReadSegment(int32 SegmentIndex, int64 SegmentPos, uint8* Dest, int64 Num);
+
+    FString Boundary;
+    TArray<FSegment> Segments;
+    int64 Size = 0;
+    int64 Position = 0;
+    bool Finalized = false;
+
+    int32 OpenSegment = INDEX_NONE;
+    TArray<ANSICHAR> OpenText;
+};
+
+/**
+ * FMythicaDataRangeStream
+ *
+ * Request body made of a range of the uploaded data, used to send the parts of a resumable upload.
+ */
+class FMythicaDataRangeStream : public FArchive
+{
+public:
+
+    FMythicaDataRangeStream(const FMythicaUploadData& InData, int64 InOffset, int64 InSize);
+
+    // FArchive interface
+    virtual void Serialize(void* Dest, int64 Num) override;
+    virtual int64 Tell() override { return Position; }
+    virtual int64 TotalSize() override { return Size; }
+    virtual void Seek(int64 InPos) override;
+    virtual bool Close() override;
+    virtual FString GetArchiveName() const override { return TEXT("FMythicaDataRangeStream"); }
+
+private:
+
+    FMythicaUploadData Data;
+    int64 Offset = 0;
+    int64 Size = 0;
+    int64 Position = 0;
+};
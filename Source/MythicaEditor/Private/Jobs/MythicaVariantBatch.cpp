@@ -0,0 +1,191 @@
+#include "Jobs/MythicaVariantBatch.h"
+
+#include "MythicaComponent.h"
+#include "ObjectTools.h"
+
+#include "MythicaEditorPrivatePCH.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(MythicaVariantBatch)
+
+bool UMythicaVariantBatch::Start(UMythicaComponent* Component, const TArray<FMythicaParameterVariant>& Variants)
+{
+    if (Running)
+    {
+        UE_LOG(LogMythica, Warning, TEXT("Variant batch is already running"));
+        return false;
+    }
+
+    if (!IsValid(Component) || !Component->GetOwner())
+    {
+        UE_LOG(LogMythica, Error, TEXT("Variant batch requires a valid component"));
+        return false;
+    }
+
+    Results.Reset();
+    RequestToResult.Reset();
+    StartTime = FPlatformTime::Seconds();
+
+    FString ComponentImportPath = Component->GetImportPath();
+
+    TArray<FMythicaParameters> ParamSets;
+    TArray<FString> ImportPaths;
+    TArray<int32> ResultIndices;
+    for (int32 i = 0; i < Variants.Num(); ++i)
+    {
+        const FMythicaParameterVariant& Variant = Variants[i];
+
+        FMythicaVariantResult& Result = Results.AddDefaulted_GetRef();
+        Result.Name = Variant.Name.IsEmpty() ? FString::Printf(TEXT("Variant%d"), i) : Variant.Name;
+
+        FMythicaParameters Params = Component->Parameters;
+        bool Valid = true;
+        for (const FMythicaParameterOverride& Override : Variant.Overrides)
+        {
+            if (!Mythica::SetParameterValue(Params, Override.Name, Override.Value))
+            {
+                Result.State = EMythicaJobState::Failed;
+                Result.Message = FText::FromString(FString::Printf(TEXT("Invalid value %s for parameter %s"), *Override.Value, *Override.Name));
+                Valid = false;
+                break;
+            }
+        }
+
+        if (!Valid)
+        {
+            UE_LOG(LogMythica, Error, TEXT("Variant %s: %s"), *Result.Name, *Result.Message.ToString());
+            continue;
+        }
+
+        ParamSets.Add(MoveTemp(Params));
+        ImportPaths.Add(ComponentImportPath + TEXT("_") + ObjectTools::SanitizeObjectName(Result.Name));
+        ResultIndices.Add(Results.Num() - 1);
+    }
+
+    if (ParamSets.IsEmpty())
+    {
+        return false;
+    }
+
+    Running = true;
+
+    UMythicaEditorSubsystem* MythicaEditorSubsystem = GEditor->GetEditorSubsystem<UMythicaEditorSubsystem>();
+    MythicaEditorSubsystem->OnJobStateChange.AddUniqueDynamic(this, &UMythicaVariantBatch::OnJobStateChanged);
+
+    TArray<int> RequestIds = MythicaEditorSubsystem->ExecuteJobBatch(
+        Component->JobDefId.JobDefId,
+        ParamSets,
+        ImportPaths,
+        Component->GetOwner()->GetActorLocation(),
+        Component);
+
+    for (int32 i = 0; i < RequestIds.Num(); ++i)
+    {
+        FMythicaVariantResult& Result = Results[ResultIndices[i]];
+        Result.RequestId = RequestIds[i];
+
+        if (RequestIds[i] > 0)
+        {
+            RequestToResult.Add(RequestIds[i], ResultIndices[i]);
+        }
+        else
+        {
+            Result.State = EMythicaJobState::Failed;
+            Result.Message = FText::FromString("Failed to create job");
+        }
+    }
+
+    UE_LOG(LogMythica, Log, TEXT("Generating %d variants of %s sharing one input upload"), RequestToResult.Num(), *Component->ToolName);
+
+    if (RequestToResult.IsEmpty())
+    {
+        Finish();
+        return false;
+    }
+
+    return true;
+}
+
+void UMythicaVariantBatch::Cancel()
+{
+    if (!Running)
+    {
+        return;
+    }
+
+    UMythicaEditorSubsystem* MythicaEditorSubsystem = GEditor->GetEditorSubsystem<UMythicaEditorSubsystem>();
+
+    TArray<int> RequestIds;
+    RequestToResult.GetKeys(RequestIds);
+    for (int RequestId : RequestIds)
+    {
+        MythicaEditorSubsystem->CancelJob(RequestId);
+    }
+}
+
+TArray<FMythicaParameterVariant> UMythicaVariantBatch::MakeParameterSweep(const FString& ParameterName, const TArray<FString>& Values)
+{
+    TArray<FMythicaParameterVariant> Variants;
+    for (const FString& Value : Values)
+    {
+        FMythicaParameterVariant& Variant = Variants.AddDefaulted_GetRef();
+        Variant.Name = FString::Printf(TEXT("%s_%s"), *ParameterName, *Value);
+
+        FMythicaParameterOverride& Override = Variant.Overrides.AddDefaulted_GetRef();
+        Override.Name = ParameterName;
+        Override.Value = Value;
+    }
+
+    return Variants;
+}
+
+void UMythicaVariantBatch::OnJobStateChanged(int RequestId, EMythicaJobState State, FText Message)
+{
+    if (State < EMythicaJobState::Completed)
+    {
+        return;
+    }
+
+    int32 ResultIndex;
+    if (!RequestToResult.RemoveAndCopyValue(RequestId, ResultIndex))
+    {
+        return;
+    }
+
+    UMythicaEditorSubsystem* MythicaEditorSubsystem = GEditor->GetEditorSubsystem<UMythicaEditorSubsystem>();
+
+    FMythicaVariantResult& Result = Results[ResultIndex];
+    Result.State = State;
+    Result.Message = Message;
+    Result.LatencySeconds = FPlatformTime::Seconds() - StartTime;
+    Result.ImportDirectory = MythicaEditorSubsystem->GetImportDirectory(RequestId);
+    if (const FMythicaJob* Job = MythicaEditorSubsystem->FindJob(RequestId))
+    {
+        Result.CacheResult = Job->CacheResult;
+    }
+
+    OnVariantFinished.Broadcast(Result);
+
+    if (RequestToResult.IsEmpty())
+    {
+        Finish();
+    }
+}
+
+void UMythicaVariantBatch::Finish()
+{
+    Running = false;
+
+    UMythicaEditorSubsystem* MythicaEditorSubsystem = GEditor->GetEditorSubsystem<UMythicaEditorSubsystem>();
+    MythicaEditorSubsystem->OnJobStateChange.RemoveDynamic(this, &UMythicaVariantBatch::OnJobStateChanged);
+
+    int32 Completed = 0;
+    for (const FMythicaVariantResult& Result : Results)
+    {
+        UE_LOG(LogMythica, Log, TEXT("Variant %s: %s in %.2fs"), *Result.Name, *UEnum::GetValueAsString(Result.State), Result.LatencySeconds);
+        Completed += Result.State == EMythicaJobState::Completed ? 1 : 0;
+    }
+
+    UE_LOG(LogMythica, Log, TEXT("Variant batch finished in %.1fs: %d of %d completed"), FPlatformTime::Seconds() - StartTime, Completed, Results.Num());
+
+    OnFinished.Broadcast(Results);
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MythicaEditorSubsystem.h"
+#include "UObject/Object.h"
+
+#include "MythicaVariantBatch.generated.h"
+
+class UMythicaComponent;
+
+USTRUCT(BlueprintType)
+struct FMythicaVariantResult
+{
+    GENERATED_BODY()
+
+public:
+
+    UPROPERTY(BlueprintReadOnly, Category = "Data")
+    FString Name = FString();
+
+    UPROPERTY(BlueprintReadOnly, Category = "Data")
+    int RequestId = -1;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Data")
+    EMythicaJobState State = EMythicaJobState::Scheduled;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Data")
+    EMythicaJobCacheResult CacheResult = EMythicaJobCacheResult::None;
+
+    /** Folder the variant's meshes were imported into */
+    UPROPERTY(BlueprintReadOnly, Category = "Data")
+    FString ImportDirectory = FString();
+
+    /** Time from starting the batch to the variant's final state */
+    UPROPERTY(BlueprintReadOnly, Category = "Data")
+    double LatencySeconds = 0.0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Data")
+    FText Message = FText();
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnVariantFinished, const FMythicaVariantResult&, Result);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnVariantBatchFinished, const TArray<FMythicaVariantResult>&, Results);
+
+/**
+ * UMythicaVariantBatch
+ *
+ * Generates variants of a component's tool with different parameter values. The inputs are exported and
+ * uploaded once for the whole batch and each variant imports into its own folder next to the component's
+ * folder, so the component's own meshes are left untouched.
+ */
+UCLASS(BlueprintType)
+class UMythicaVariantBatch : public UObject
+{
+    GENERATED_BODY()
+
+public:
+
+    /** Submit a job per variant, returns false if no job could be submitted */
+    bool Start(UMythicaComponent* Component, const TArray<FMythicaParameterVariant>& Variants);
+
+    UFUNCTION(BlueprintCallable, Category = "Mythica")
+    void Cancel();
+
+    UFUNCTION(BlueprintPure, Category = "Mythica")
+    bool IsRunning() const { return Running; }
+
+    UFUNCTION(BlueprintPure, Category = "Mythica")
+    TArray<FMythicaVariantResult> GetResults() const { return Results; }
+
+    /** One variant per value of a single parameter */
+    UFUNCTION(BlueprintPure, Category = "Mythica")
+    static TArray<FMythicaParameterVariant> MakeParameterSweep(const FString& ParameterName, const TArray<FString>& Values);
+
+    UPROPERTY(BlueprintAssignable, Category = "Mythica")
+    FOnVariantFinished OnVariantFinished;
+
+    UPROPERTY(BlueprintAssignable, Category = "Mythica")
+    FOnVariantBatchFinished OnFinished;
+
+private:
+
+    UFUNCTION()
+    void OnJobStateChanged(int RequestId, EMythicaJobState State, FText Message);
+
+    void Finish();
+
+    TArray<FMythicaVariantResult> Results;
+    TMap<int, int32> RequestToResult;
+
+    double StartTime = 0.0;
+    bool Running = false;
+};
@@ -0,0 +1,374 @@
+#include "Jobs/MythicaWorldPartitionRegenerate.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Components/StaticMeshComponent.h"
+#include "FileHelpers.h"
+#include "HAL/PlatformMemory.h"
+#include "MythicaComponent.h"
+#include "MythicaDeveloperSettings.h"
+#include "WorldPartition/LoaderAdapter/LoaderAdapterShape.h"
+#include "WorldPartition/WorldPartition.h"
+#include "WorldPartition/WorldPartitionEditorLoaderAdapter.h"
+
+#include "MythicaEditorPrivatePCH.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(MythicaWorldPartitionRegenerate)
+
+void UMythicaWorldPartitionRegenerate::Start(UWorld* InWorld, bool bForce, FMythicaComponentFilter InFilter)
+{
+    if (Running)
+    {
+        UE_LOG(LogMythica, Warning, TEXT("World partition regenerate is already running"));
+        return;
+    }
+
+    UWorldPartition* WorldPartition = InWorld ? InWorld->GetWorldPartition() : nullptr;
+    if (!WorldPartition)
+    {
+        UE_LOG(LogMythica, Error, TEXT("World partition regenerate requires a partitioned world"));
+        return;
+    }
+
+    const UMythicaDeveloperSettings* Settings = GetDefault<UMythicaDeveloperSettings>();
+    double RegionSize = FMath::Max(Settings->WorldPartitionRegionSize, 100.0f);
+
+    FBox WorldBounds = WorldPartition->GetEditorWorldBounds();
+    if (!WorldBounds.IsValid)
+    {
+        UE_LOG(LogMythica, Warning, TEXT("World partition has no actors to regenerate"));
+        return;
+    }
+
+    // Serpentine order keeps consecutive regions adjacent so padding cells stay warm in the caches
+    PendingRegions.Reset();
+    int32 NumX = FMath::CeilToInt((WorldBounds.Max.X - WorldBounds.Min.X) / RegionSize);
+    int32 NumY = FMath::CeilToInt((WorldBounds.Max.Y - WorldBounds.Min.Y) / RegionSize);
+    for (int32 Y = 0; Y < FMath::Max(NumY, 1); ++Y)
+    {
+        for (int32 i = 0; i < FMath::Max(NumX, 1); ++i)
+        {
+            int32 X = (Y % 2 == 0) ? i : NumX - 1 - i;
+
+            FVector Min(WorldBounds.Min.X + X * RegionSize, WorldBounds.Min.Y + Y * RegionSize, WorldBounds.Min.Z);
+            FVector Max(Min.X + RegionSize, Min.Y + RegionSize, WorldBounds.Max.Z);
+            PendingRegions.Add(FBox(Min, Max));
+        }
+    }
+
+    World = InWorld;
+    Force = bForce;
+    Filter = MoveTemp(InFilter);
+    Running = true;
+    Canceled = false;
+    SecondPass = false;
+    DeferredComponents.Reset();
+    DeferredRegions.Reset();
+    StartTime = FPlatformTime::Seconds();
+    TotalJobSeconds = 0.0;
+    RegionsProcessed = 0;
+    PeakMemoryMB = GetUsedMemoryMB();
+    Progress = FMythicaBulkRegenerateProgress();
+
+    if (!BulkRegenerate)
+    {
+        BulkRegenerate = NewObject<UMythicaBulkRegenerate>(this);
+        BulkRegenerate->OnFinished.AddDynamic(this, &UMythicaWorldPartitionRegenerate::OnRegionFinished);
+    }
+
+    UE_LOG(LogMythica, Log, TEXT("World partition regenerate of %d regions of %.0fm"), PendingRegions.Num(), RegionSize / 100.0f);
+
+    ProcessNextRegion();
+}
+
+void UMythicaWorldPartitionRegenerate::Cancel()
+{
+    if (!Running)
+    {
+        return;
+    }
+
+    PendingRegions.Reset();
+    DeferredRegions.Reset();
+    Canceled = true;
+
+    // Finishing the region finishes the operation since no regions are left
+    if (BulkRegenerate->IsRunning())
+    {
+        BulkRegenerate->Cancel();
+    }
+    else
+    {
+        Finish();
+    }
+}
+
+void UMythicaWorldPartitionRegenerate::ProcessNextRegion()
+{
+    NextRegionTimer.Invalidate();
+
+    if (World.IsValid() && PendingRegions.IsEmpty() && !DeferredRegions.IsEmpty())
+    {
+        UE_LOG(LogMythica, Log, TEXT("Regenerating %d components that take input from later regions in %d regions"), DeferredComponents.Num(), DeferredRegions.Num());
+
+        SecondPass = true;
+        PendingRegions = MoveTemp(DeferredRegions);
+        DeferredRegions.Reset();
+    }
+
+    if (!World.IsValid() || PendingRegions.IsEmpty())
+    {
+        Finish();
+        return;
+    }
+
+    const UMythicaDeveloperSettings* Settings = GetDefault<UMythicaDeveloperSettings>();
+
+    CurrentRegion = PendingRegions[0];
+    PendingRegions.RemoveAt(0);
+
+    LoadRegion(CurrentRegion);
+
+    // Split regions that don't fit under the memory ceiling
+    uint64 UsedMemoryMB = GetUsedMemoryMB();
+    PeakMemoryMB = FMath::Max(PeakMemoryMB, UsedMemoryMB);
+
+    double RegionSize = CurrentRegion.GetSize().X;
+    if (UsedMemoryMB > (uint64)Settings->WorldPartitionMemoryCeilingMB && RegionSize > Settings->WorldPartitionMinRegionSize)
+    {
+        UE_LOG(LogMythica, Log, TEXT("Region at %s uses %llu MB, above the ceiling of %d MB, splitting it"), *CurrentRegion.GetCenter().ToString(), UsedMemoryMB, Settings->WorldPartitionMemoryCeilingMB);
+
+        UnloadRegion();
+
+        FVector Center = CurrentRegion.GetCenter();
+        FVector Min = CurrentRegion.Min;
+        FVector Max = CurrentRegion.Max;
+        PendingRegions.Insert({
+            FBox(FVector(Min.X, Min.Y, Min.Z), FVector(Center.X, Center.Y, Max.Z)),
+            FBox(FVector(Center.X, Min.Y, Min.Z), FVector(Max.X, Center.Y, Max.Z)),
+            FBox(FVector(Center.X, Center.Y, Min.Z), FVector(Max.X, Max.Y, Max.Z)),
+            FBox(FVector(Min.X, Center.Y, Min.Z), FVector(Center.X, Max.Y, Max.Z))
+        }, 0);
+
+        NextRegionTimer = GEditor->GetTimerManager()->SetTimerForNextTick(FTimerDelegate::CreateUObject(this, &UMythicaWorldPartitionRegenerate::ProcessNextRegion));
+        return;
+    }
+
+    // Only regenerate components owned by the region, the padding just provides their inputs
+    TArray<UMythicaComponent*> Components;
+    UMythicaBulkRegenerate::GatherComponents(World.Get(), Components);
+    Components.RemoveAll([this](const UMythicaComponent* Component)
+    {
+        FVector Location = Component->GetOwner()->GetActorLocation();
+        return Location.X < CurrentRegion.Min.X || Location.X >= CurrentRegion.Max.X
+            || Location.Y < CurrentRegion.Min.Y || Location.Y >= CurrentRegion.Max.Y
+            || (Filter && !Filter(Component));
+    });
+
+    // Consumers of components in unvisited regions would read their stale meshes, the second pass runs them after
+    // their producers. Producers outside the loaded padding can't be seen and are not waited for.
+    if (SecondPass)
+    {
+        Components.RemoveAll([this](const UMythicaComponent* Component)
+        {
+            return !DeferredComponents.Contains(FSoftObjectPath(Component));
+        });
+    }
+    else
+    {
+        Components.RemoveAll([this](const UMythicaComponent* Component)
+        {
+            if (!HasUnvisitedProducer(Component))
+            {
+                return false;
+            }
+
+            DeferredComponents.Add(FSoftObjectPath(Component));
+            DeferredRegions.AddUnique(CurrentRegion);
+            return true;
+        });
+    }
+
+    if (Components.IsEmpty())
+    {
+        UnloadRegion();
+        RegionsProcessed++;
+
+        NextRegionTimer = GEditor->GetTimerManager()->SetTimerForNextTick(FTimerDelegate::CreateUObject(this, &UMythicaWorldPartitionRegenerate::ProcessNextRegion));
+        return;
+    }
+
+    RegionComponents.Reset();
+    for (UMythicaComponent* Component : Components)
+    {
+        RegionComponents.Add(Component);
+    }
+
+    UE_LOG(LogMythica, Log, TEXT("Regenerating %d components in region at %s, %d regions left, %llu MB used"), Components.Num(), *CurrentRegion.GetCenter().ToString(), PendingRegions.Num(), UsedMemoryMB);
+
+    BulkRegenerate->Start(Components, Force);
+}
+
+void UMythicaWorldPartitionRegenerate::OnRegionFinished(const FMythicaBulkRegenerateProgress& RegionProgress)
+{
+    PeakMemoryMB = FMath::Max(PeakMemoryMB, GetUsedMemoryMB());
+
+    Progress.TotalComponents += RegionProgress.TotalComponents;
+    Progress.SkippedComponents += RegionProgress.SkippedComponents;
+    Progress.CompletedJobs += RegionProgress.CompletedJobs;
+    Progress.FailedJobs += RegionProgress.FailedJobs;
+    TotalJobSeconds += RegionProgress.AverageJobSeconds * (RegionProgress.CompletedJobs + RegionProgress.FailedJobs);
+
+    // A canceled region may be half generated, leave it for the user to save or discard
+    if (!Canceled)
+    {
+        SaveRegion();
+    }
+    RegionComponents.Reset();
+
+    UnloadRegion();
+    RegionsProcessed++;
+
+    NextRegionTimer = GEditor->GetTimerManager()->SetTimerForNextTick(FTimerDelegate::CreateUObject(this, &UMythicaWorldPartitionRegenerate::ProcessNextRegion));
+}
+
+bool UMythicaWorldPartitionRegenerate::HasUnvisitedProducer(const UMythicaComponent* Component) const
+{
+    TSet<AActor*> InputActors;
+    UMythicaBulkRegenerate::GetInputActors(Component, InputActors);
+
+    for (AActor* InputActor : InputActors)
+    {
+        // Producers the filter leaves out are not regenerated, there is nothing to wait for
+        const UMythicaComponent* Producer = InputActor ? InputActor->FindComponentByClass<UMythicaComponent>() : nullptr;
+        if (!Producer || (Filter && !Filter(Producer)))
+        {
+            continue;
+        }
+
+        // Producers in the current region are ordered by the bulk regenerate
+        FVector Location = InputActor->GetActorLocation();
+        if (Location.X >= CurrentRegion.Min.X && Location.X < CurrentRegion.Max.X && Location.Y >= CurrentRegion.Min.Y && Location.Y < CurrentRegion.Max.Y)
+        {
+            continue;
+        }
+
+        for (const FBox& Region : PendingRegions)
+        {
+            if (Location.X >= Region.Min.X && Location.X < Region.Max.X && Location.Y >= Region.Min.Y && Location.Y < Region.Max.Y)
+            {
+                UE_LOG(LogMythica, Log, TEXT("Deferring %s on %s, it takes input from %s in a later region"), *Component->GetName(), *Component->GetOwner()->GetActorLabel(), *InputActor->GetActorLabel());
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+void UMythicaWorldPartitionRegenerate::SaveRegion()
+{
+    // Save the generated assets and the actors that reference them before the region is unloaded, other
+    // dirty packages belong to the user and are left alone
+    const UMythicaDeveloperSettings* Settings = GetDefault<UMythicaDeveloperSettings>();
+    FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
+
+    TSet<UPackage*> Packages;
+    for (const TWeakObjectPtr<UMythicaComponent>& Component : RegionComponents)
+    {
+        if (!Component.IsValid())
+        {
+            continue;
+        }
+
+        if (AActor* Owner = Component->GetOwner())
+        {
+            Packages.Add(Owner->GetPackage());
+        }
+
+        for (UActorComponent* MeshComponent : Component->GetGeneratedMeshComponents())
+        {
+            UStaticMeshComponent* StaticMeshComponent = Cast<UStaticMeshComponent>(MeshComponent);
+            UStaticMesh* Mesh = StaticMeshComponent ? StaticMeshComponent->GetStaticMesh() : nullptr;
+            if (Mesh)
+            {
+                Packages.Add(Mesh->GetPackage());
+            }
+        }
+
+        // Materials and textures imported with the meshes
+        FString ImportDirectory = FPaths::Combine(Settings->GeneratedAssetImportDirectory, Component->GetImportPath());
+        TArray<FAssetData> Assets;
+        AssetRegistryModule.Get().GetAssetsByPath(*ImportDirectory, Assets, true, false);
+        for (const FAssetData& Asset : Assets)
+        {
+            if (UPackage* Package = FindObject<UPackage>(nullptr, *Asset.PackageName.ToString()))
+            {
+                Packages.Add(Package);
+            }
+        }
+    }
+
+    TArray<UPackage*> DirtyPackages;
+    for (UPackage* Package : Packages)
+    {
+        if (Package && Package->IsDirty())
+        {
+            DirtyPackages.Add(Package);
+        }
+    }
+
+    if (!DirtyPackages.IsEmpty())
+    {
+        UEditorLoadingAndSavingUtils::SavePackages(DirtyPackages, true);
+    }
+}
+
+void UMythicaWorldPartitionRegenerate::LoadRegion(const FBox& Region)
+{
+    const UMythicaDeveloperSettings* Settings = GetDefault<UMythicaDeveloperSettings>();
+
+    UWorldPartition* WorldPartition = World->GetWorldPartition();
+    FBox LoadBox = Region.ExpandBy(FVector(Settings->WorldPartitionLoadPadding, Settings->WorldPartitionLoadPadding, 0.0f));
+
+    LoaderAdapter = WorldPartition->CreateEditorLoaderAdapter<FLoaderAdapterShape>(World.Get(), LoadBox, TEXT("Mythica Regenerate"));
+    LoaderAdapter->GetLoaderAdapter()->Load();
+}
+
+void UMythicaWorldPartitionRegenerate::UnloadRegion()
+{
+    if (LoaderAdapter)
+    {
+        LoaderAdapter->GetLoaderAdapter()->Unload();
+
+        if (World.IsValid() && World->GetWorldPartition())
+        {
+            World->GetWorldPartition()->ReleaseEditorLoaderAdapter(LoaderAdapter);
+        }
+        LoaderAdapter = nullptr;
+    }
+
+    CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+}
+
+void UMythicaWorldPartitionRegenerate::Finish()
+{
+    GEditor->GetTimerManager()->ClearTimer(NextRegionTimer);
+    UnloadRegion();
+
+    Running = false;
+
+    int32 FinishedJobs = Progress.CompletedJobs + Progress.FailedJobs;
+    Progress.ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+    Progress.AverageJobSeconds = FinishedJobs > 0 ? TotalJobSeconds / FinishedJobs : 0.0;
+    Progress.JobsPerMinute = Progress.ElapsedSeconds > 0.0 ? FinishedJobs * 60.0 / Progress.ElapsedSeconds : 0.0;
+
+    UE_LOG(LogMythica, Log, TEXT("World partition regenerate finished in %.1fs over %d regions: %d completed, %d failed, %d skipped, %.1f jobs/min, %llu MB peak memory"),
+        Progress.ElapsedSeconds, RegionsProcessed, Progress.CompletedJobs, Progress.FailedJobs, Progress.SkippedComponents, Progress.JobsPerMinute, PeakMemoryMB);
+
+    OnFinished.Broadcast(Progress);
+}
+
+uint64 UMythicaWorldPartitionRegenerate::GetUsedMemoryMB()
+{
+    return FPlatformMemory::GetStats().UsedPhysical / (1024 * 1024);
+}
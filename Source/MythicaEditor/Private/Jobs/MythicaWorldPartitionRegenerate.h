@@ -0,0 +1,91 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Jobs/MythicaBulkRegenerate.h"
+#include "UObject/Object.h"
+
+#include "MythicaWorldPartitionRegenerate.generated.h"
+
+class UMythicaComponent;
+class UWorldPartitionEditorLoaderAdapter;
+
+/** Selects the components a world partition regenerate visits, null regenerates all of them */
+using FMythicaComponentFilter = TFunction<bool(const UMythicaComponent*)>;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnWorldPartitionRegenerateFinished, const FMythicaBulkRegenerateProgress&, Progress);
+
+/**
+ * UMythicaWorldPartitionRegenerate
+ *
+ * Regenerates the Mythica components of a World Partition map without loading the whole world. The world
+ * bounds are split into regions that are visited in serpentine order. Each region is loaded with some padding
+ * so that inputs in neighbouring cells are available, its components are regenerated, the results are saved
+ * and the region is unloaded before moving on. Regions that push the editor over the memory ceiling are
+ * unloaded and split into smaller regions. Components that take input from a component in a later region are
+ * regenerated in a second pass, producers outside the load padding of their consumer are not detected.
+ */
+UCLASS()
+class UMythicaWorldPartitionRegenerate : public UObject
+{
+    GENERATED_BODY()
+
+public:
+
+    void Start(UWorld* World, bool bForce, FMythicaComponentFilter InFilter = nullptr);
+    void Cancel();
+
+    bool IsRunning() const { return Running; }
+
+    /** Totals over all regions processed so far */
+    const FMythicaBulkRegenerateProgress& GetProgress() const { return Progress; }
+
+    UPROPERTY(BlueprintAssignable, Category = "Mythica")
+    FOnWorldPartitionRegenerateFinished OnFinished;
+
+private:
+
+    void ProcessNextRegion();
+    void LoadRegion(const FBox& Region);
+    void UnloadRegion();
+    void Finish();
+    void SaveRegion();
+    bool HasUnvisitedProducer(const UMythicaComponent* Component) const;
+
+    UFUNCTION()
+    void OnRegionFinished(const FMythicaBulkRegenerateProgress& RegionProgress);
+
+    static uint64 GetUsedMemoryMB();
+
+    UPROPERTY()
+    TObjectPtr<UMythicaBulkRegenerate> BulkRegenerate = nullptr;
+
+    UPROPERTY()
+    TObjectPtr<UWorldPartitionEditorLoaderAdapter> LoaderAdapter = nullptr;
+
+    TWeakObjectPtr<UWorld> World;
+    TArray<FBox> PendingRegions;
+    FBox CurrentRegion;
+
+    /** Components regenerated in the current region, their actors and generated assets are saved with it */
+    TArray<TWeakObjectPtr<UMythicaComponent>> RegionComponents;
+
+    /**
+     * Components that take input from a component in a region that wasn't visited yet. They are skipped on the
+     * first pass and regenerated in a second pass over their regions once every producer ran.
+     */
+    TSet<FSoftObjectPath> DeferredComponents;
+    TArray<FBox> DeferredRegions;
+    bool SecondPass = false;
+
+    FMythicaBulkRegenerateProgress Progress;
+    double StartTime = 0.0;
+    double TotalJobSeconds = 0.0;
+    int32 RegionsProcessed = 0;
+    uint64 PeakMemoryMB = 0;
+    FMythicaComponentFilter Filter;
+    bool Force = false;
+    bool Running = false;
+    bool Canceled = false;
+
+    FTimerHandle NextRegionTimer;
+};
@@ -0,0 +1,361 @@
+#include "MythicaCompactMesh.h"
+
+#include "MythicaEditorPrivatePCH.h"
+
+const TCHAR* Mythica::CompactMeshExtension = TEXT("mcm");
+
+static const uint8 CompactMeshMagic[4] = { 'M', 'Y', 'C', 'M' };
+static const uint16 CompactMeshVersion = 1;
+
+static const uint16 CompactMeshHasNormals = 1 << 0;
+static const uint16 CompactMeshHasUVs = 1 << 1;
+
+static const float QuantizedMax = 65535.0f;
+static const float SnormMax = 32767.0f;
+
+// Decoded normals may differ from the source by a few thousandths of a degree
+static const float NormalToleranceDegrees = 0.05f;
+
+template <typename T>
+static void WriteValue(TArray64<uint8>& Out, const T& Value)
+{
+    Out.Append((const uint8*)&Value, sizeof(T));
+}
+
+template <typename T>
+static bool ReadValue(const TArray64<uint8>& Data, int64& Offset, T& OutValue)
+{
+    if (Offset + (int64)sizeof(T) > Data.Num())
+    {
+        return false;
+    }
+
+    FMemory::Memcpy(&OutValue, Data.GetData() + Offset, sizeof(T));
+    Offset += sizeof(T);
+    return true;
+}
+
+static uint16 Quantize(float Value, float Min, float Range)
+{
+    return Range > 0.0f ? (uint16)FMath::RoundToInt(FMath::Clamp((Value - Min) / Range, 0.0f, 1.0f) * QuantizedMax) : 0;
+}
+
+static float Dequantize(uint16 Value, float Min, float Range)
+{
+    return Min + (Value / QuantizedMax) * Range;
+}
+
+static int16 QuantizeSnorm(float Value)
+{
+    return (int16)FMath::RoundToInt(FMath::Clamp(Value, -1.0f, 1.0f) * SnormMax);
+}
+
+// Octahedral encoding projects the unit sphere onto an octahedron and unfolds it into a square
+static FVector2f EncodeOctahedral(const FVector3f& Normal)
+{
+    float Length = FMath::Abs(Normal.X) + FMath::Abs(Normal.Y) + FMath::Abs(Normal.Z);
+    if (Length <= 0.0f)
+    {
+        return FVector2f::ZeroVector;
+    }
+
+    FVector3f N = Normal / Length;
+    if (N.Z >= 0.0f)
+    {
+        return FVector2f(N.X, N.Y);
+    }
+
+    return FVector2f((1.0f - FMath::Abs(N.Y)) * (N.X >= 0.0f ? 1.0f : -1.0f), (1.0f - FMath::Abs(N.X)) * (N.Y >= 0.0f ? 1.0f : -1.0f));
+}
+
+static FVector3f DecodeOctahedral(const FVector2f& Encoded)
+{
+    FVector3f N(Encoded.X, Encoded.Y, 1.0f - FMath::Abs(Encoded.X) - FMath::Abs(Encoded.Y));
+    float Fold = FMath::Max(-N.Z, 0.0f);
+    N.X += N.X >= 0.0f ? -Fold : Fold;
+    N.Y += N.Y >= 0.0f ? -Fold : Fold;
+    return N.GetSafeNormal();
+}
+
+static void WriteVarint(TArray64<uint8>& Out, uint64 Value)
+{
+    while (Value >= 0x80)
+    {
+        Out.Add((uint8)(Value | 0x80));
+        Value >>= 7;
+    }
+    Out.Add((uint8)Value);
+}
+
+static bool ReadVarint(const TArray64<uint8>& Data, int64& Offset, uint64& OutValue)
+{
+    OutValue = 0;
+    for (int32 Shift = 0; Shift < 64; Shift += 7)
+    {
+        if (Offset >= Data.Num())
+        {
+            return false;
+        }
+
+        uint8 Byte = Data[Offset++];
+        OutValue |= (uint64)(Byte & 0x7f) << Shift;
+        if ((Byte & 0x80) == 0)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static FBox3f ComputeBounds(const TArray<FVector3f>& Positions)
+{
+    FBox3f Bounds(ForceInit);
+    for (const FVector3f& Position : Positions)
+    {
+        Bounds += Position;
+    }
+    return Bounds.IsValid ? Bounds : FBox3f(FVector3f::ZeroVector, FVector3f::ZeroVector);
+}
+
+static FBox2f ComputeUVBounds(const TArray<FVector2f>& UVs)
+{
+    FBox2f Bounds(ForceInit);
+    for (const FVector2f& UV : UVs)
+    {
+        Bounds += UV;
+    }
+    return Bounds.bIsValid ? Bounds : FBox2f(FVector2f::ZeroVector, FVector2f::ZeroVector);
+}
+
+bool Mythica::EncodeCompactMesh(const FMythicaCompactMeshData& Mesh, TArray64<uint8>& OutData)
+{
+    OutData.Reset();
+
+    int32 NumVertices = Mesh.Positions.Num();
+    bool HasNormals = !Mesh.Normals.IsEmpty();
+    bool HasUVs = !Mesh.UVs.IsEmpty();
+    if ((HasNormals && Mesh.Normals.Num() != NumVertices) || (HasUVs && Mesh.UVs.Num() != NumVertices) || Mesh.Indices.Num() % 3 != 0)
+    {
+        UE_LOG(LogMythicaEditor, Error, TEXT("Compact mesh attributes don't match its vertices"));
+        return false;
+    }
+
+    FBox3f Bounds = ComputeBounds(Mesh.Positions);
+    FVector3f Range = Bounds.Max - Bounds.Min;
+    FBox2f UVBounds = ComputeUVBounds(Mesh.UVs);
+    FVector2f UVRange = UVBounds.Max - UVBounds.Min;
+
+    uint16 Flags = (HasNormals ? CompactMeshHasNormals : 0) | (HasUVs ? CompactMeshHasUVs : 0);
+
+    OutData.Append(CompactMeshMagic, sizeof(CompactMeshMagic));
+    WriteValue(OutData, CompactMeshVersion);
+    WriteValue(OutData, Flags);
+    WriteValue(OutData, (uint32)NumVertices);
+    WriteValue(OutData, (uint32)Mesh.Indices.Num());
+    WriteValue(OutData, Bounds.Min);
+    WriteValue(OutData, Bounds.Max);
+    if (HasUVs)
+    {
+        WriteValue(OutData, UVBounds.Min);
+        WriteValue(OutData, UVBounds.Max);
+    }
+
+    int64 AttributeSize = (int64)NumVertices * ((3 + (HasNormals ? 2 : 0) + (HasUVs ? 2 : 0)) * sizeof(uint16));
+    OutData.Reserve(OutData.Num() + AttributeSize + Mesh.Indices.Num() * 2);
+
+    for (const FVector3f& Position : Mesh.Positions)
+    {
+        WriteValue(OutData, Quantize(Position.X, Bounds.Min.X, Range.X));
+        WriteValue(OutData, Quantize(Position.Y, Bounds.Min.Y, Range.Y));
+        WriteValue(OutData, Quantize(Position.Z, Bounds.Min.Z, Range.Z));
+    }
+
+    for (const FVector3f& Normal : Mesh.Normals)
+    {
+        FVector2f Encoded = EncodeOctahedral(Normal);
+        WriteValue(OutData, QuantizeSnorm(Encoded.X));
+        WriteValue(OutData, QuantizeSnorm(Encoded.Y));
+    }
+
+    for (const FVector2f& UV : Mesh.UVs)
+    {
+        WriteValue(OutData, Quantize(UV.X, UVBounds.Min.X, UVRange.X));
+        WriteValue(OutData, Quantize(UV.Y, UVBounds.Min.Y, UVRange.Y));
+    }
+
+    // Neighbouring triangles share vertices, so indices are stored as zigzag coded differences to the previous one
+    int64 Previous = 0;
+    for (uint32 Index : Mesh.Indices)
+    {
+        if (Index >= (uint32)NumVertices)
+        {
+            UE_LOG(LogMythicaEditor, Error, TEXT("Compact mesh index %u is out of range"), Index);
+            OutData.Reset();
+            return false;
+        }
+
+        int64 Delta = (int64)Index - Previous;
+        WriteVarint(OutData, (uint64)((Delta << 1) ^ (Delta >> 63)));
+        Previous = Index;
+    }
+
+    return true;
+}
+
+bool Mythica::DecodeCompactMesh(const TArray64<uint8>& Data, FMythicaCompactMeshData& OutMesh)
+{
+    OutMesh = FMythicaCompactMeshData();
+
+    if (!IsCompactMesh(Data.GetData(), Data.Num()))
+    {
+        UE_LOG(LogMythicaEditor, Error, TEXT("Data is not a compact mesh"));
+        return false;
+    }
+
+    int64 Offset = sizeof(CompactMeshMagic);
+    uint16 Version = 0;
+    uint16 Flags = 0;
+    uint32 NumVertices = 0;
+    uint32 NumIndices = 0;
+    FBox3f Bounds(ForceInit);
+    FBox2f UVBounds(FVector2f::ZeroVector, FVector2f::ZeroVector);
+
+    bool Success = ReadValue(Data, Offset, Version) && ReadValue(Data, Offset, Flags)
+        && ReadValue(Data, Offset, NumVertices) && ReadValue(Data, Offset, NumIndices)
+        && ReadValue(Data, Offset, Bounds.Min) && ReadValue(Data, Offset, Bounds.Max);
+    if (Success && (Flags & CompactMeshHasUVs))
+    {
+        Success = ReadValue(Data, Offset, UVBounds.Min) && ReadValue(Data, Offset, UVBounds.Max);
+    }
+
+    if (!Success || Version != CompactMeshVersion || NumIndices % 3 != 0)
+    {
+        UE_LOG(LogMythicaEditor, Error, TEXT("Unsupported or truncated compact mesh header"));
+        return false;
+    }
+
+    bool HasNormals = (Flags & CompactMeshHasNormals) != 0;
+    bool HasUVs = (Flags & CompactMeshHasUVs) != 0;
+
+    // Every index takes at least a byte, which bounds the counts before anything is allocated
+    int64 AttributeSize = (int64)NumVertices * ((3 + (HasNormals ? 2 : 0) + (HasUVs ? 2 : 0)) * sizeof(uint16));
+    if (NumVertices > (uint32)MAX_int32 || NumIndices > (uint32)MAX_int32 || Offset + AttributeSize + NumIndices > Data.Num())
+    {
+        UE_LOG(LogMythicaEditor, Error, TEXT("Truncated compact mesh"));
+        return false;
+    }
+
+    FVector3f Range = Bounds.Max - Bounds.Min;
+    FVector2f UVRange = UVBounds.Max - UVBounds.Min;
+
+    const uint16* Values = (const uint16*)(Data.GetData() + Offset);
+
+    OutMesh.Positions.SetNumUninitialized(NumVertices);
+    for (uint32 i = 0; i < NumVertices; ++i, Values += 3)
+    {
+        OutMesh.Positions[i] = FVector3f(
+            Dequantize(Values[0], Bounds.Min.X, Range.X),
+            Dequantize(Values[1], Bounds.Min.Y, Range.Y),
+            Dequantize(Values[2], Bounds.Min.Z, Range.Z));
+    }
+
+    if (HasNormals)
+    {
+        OutMesh.Normals.SetNumUninitialized(NumVertices);
+        for (uint32 i = 0; i < NumVertices; ++i, Values += 2)
+        {
+            OutMesh.Normals[i] = DecodeOctahedral(FVector2f((int16)Values[0] / SnormMax, (int16)Values[1] / SnormMax));
+        }
+    }
+
+    if (HasUVs)
+    {
+        OutMesh.UVs.SetNumUninitialized(NumVertices);
+        for (uint32 i = 0; i < NumVertices; ++i, Values += 2)
+        {
+            OutMesh.UVs[i] = FVector2f(Dequantize(Values[0], UVBounds.Min.X, UVRange.X), Dequantize(Values[1], UVBounds.Min.Y, UVRange.Y));
+        }
+    }
+
+    Offset += AttributeSize;
+
+    OutMesh.Indices.SetNumUninitialized(NumIndices);
+    int64 Previous = 0;
+    for (uint32 i = 0; i < NumIndices; ++i)
+    {
+        uint64 ZigZag = 0;
+        if (!ReadVarint(Data, Offset, ZigZag))
+        {
+            UE_LOG(LogMythicaEditor, Error, TEXT("Truncated compact mesh indices"));
+            return false;
+        }
+
+        int64 Index = Previous + (int64)((ZigZag >> 1) ^ (~(ZigZag & 1) + 1));
+        if (Index < 0 || Index >= NumVertices)
+        {
+            UE_LOG(LogMythicaEditor, Error, TEXT("Compact mesh index %lld is out of range"), Index);
+            return false;
+        }
+
+        OutMesh.Indices[i] = (uint32)Index;
+        Previous = Index;
+    }
+
+    return true;
+}
+
+bool Mythica::IsCompactMesh(const uint8* Data, int64 Size)
+{
+    return Size >= (int64)sizeof(CompactMeshMagic) && FMemory::Memcmp(Data, CompactMeshMagic, sizeof(CompactMeshMagic)) == 0;
+}
+
+FMythicaCompactMeshError Mythica::MeasureCompactMeshError(const FMythicaCompactMeshData& Source, const FMythicaCompactMeshData& Decoded)
+{
+    FMythicaCompactMeshError Error;
+    Error.TopologyMatches = Source.Indices == Decoded.Indices
+        && Source.Positions.Num() == Decoded.Positions.Num()
+        && Source.Normals.Num() == Decoded.Normals.Num()
+        && Source.UVs.Num() == Decoded.UVs.Num();
+    if (!Error.TopologyMatches)
+    {
+        return Error;
+    }
+
+    // Rounding to the nearest step is off by at most half a step, the other half covers float precision
+    FVector3f Range = ComputeBounds(Source.Positions).GetSize();
+    Error.PositionTolerance = Range.GetMax() / QuantizedMax;
+
+    FVector2f UVRange = ComputeUVBounds(Source.UVs).GetSize();
+    Error.UVTolerance = UVRange.GetMax() / QuantizedMax;
+
+    for (int32 i = 0; i < Source.Positions.Num(); ++i)
+    {
+        Error.MaxPositionError = FMath::Max(Error.MaxPositionError, (Source.Positions[i] - Decoded.Positions[i]).GetAbsMax());
+    }
+
+    for (int32 i = 0; i < Source.Normals.Num(); ++i)
+    {
+        FVector3f SourceNormal = Source.Normals[i].GetSafeNormal();
+        if (!SourceNormal.IsZero())
+        {
+            float Cosine = FMath::Clamp(FVector3f::DotProduct(SourceNormal, Decoded.Normals[i]), -1.0f, 1.0f);
+            Error.MaxNormalErrorDegrees = FMath::Max(Error.MaxNormalErrorDegrees, FMath::RadiansToDegrees(FMath::Acos(Cosine)));
+        }
+    }
+
+    for (int32 i = 0; i < Source.UVs.Num(); ++i)
+    {
+        Error.MaxUVError = FMath::Max(Error.MaxUVError, (Source.UVs[i] - Decoded.UVs[i]).GetAbsMax());
+    }
+
+    return Error;
+}
+
+bool FMythicaCompactMeshError::IsWithinTolerance() const
+{
+    return TopologyMatches
+        && MaxPositionError <= PositionTolerance + KINDA_SMALL_NUMBER
+        && MaxNormalErrorDegrees <= NormalToleranceDegrees
+        && MaxUVError <= UVTolerance + KINDA_SMALL_NUMBER;
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Triangle mesh carried by the compact mesh encoding, attributes are per vertex */
+struct FMythicaCompactMeshData
+{
+    TArray<FVector3f> Positions;
+    TArray<FVector3f> Normals;
+    TArray<FVector2f> UVs;
+    TArray<uint32> Indices;
+};
+
+/** Differences between a mesh and its encoded and decoded copy */
+struct FMythicaCompactMeshError
+{
+    bool TopologyMatches = false;
+
+    float MaxPositionError = 0.0f;
+    float PositionTolerance = 0.0f;
+    float MaxNormalErrorDegrees = 0.0f;
+    float MaxUVError = 0.0f;
+    float UVTolerance = 0.0f;
+
+    bool IsWithinTolerance() const;
+};
+
+namespace Mythica
+{
+    /** Extension of compact mesh files */
+    extern const TCHAR* CompactMeshExtension;
+
+    /**
+     * Encodes a mesh for transport. Positions and UVs are quantized to 16 bits relative to their bounds, normals
+     * are octahedral encoded and indices are delta and varint coded. All values are little endian.
+     */
+    bool EncodeCompactMesh(const FMythicaCompactMeshData& Mesh, TArray64<uint8>& OutData);
+    bool DecodeCompactMesh(const TArray64<uint8>& Data, FMythicaCompactMeshData& OutMesh);
+
+    /** Whether the data starts with the compact mesh header */
+    bool IsCompactMesh(const uint8* Data, int64 Size);
+
+    FMythicaCompactMeshError MeasureCompactMeshError(const FMythicaCompactMeshData& Source, const FMythicaCompactMeshData& Decoded);
+}
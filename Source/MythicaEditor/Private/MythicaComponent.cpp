@@ -2,6 +2,7 @@
 
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "Components/StaticMeshComponent.h"
+#include "Jobs/MythicaJobFingerprint.h"
 #include "Kismet/KismetSystemLibrary.h"
 #include "ObjectTools.h"
 #include "PropertyEditorModule.h"
@@ -19,12 +20,13 @@ struct FMythicaProcessingStep
 };
 
 const FMythicaProcessingStep ProcessingSteps[] = {
+    { EMythicaJobState::Scheduled, 0.1f },
     { EMythicaJobState::Requesting, 0.1f },
     { EMythicaJobState::Queued, 0.1f },
     { EMythicaJobState::Processing, 5.0f },
     { EMythicaJobState::Importing, 0.25f }
 };
-static_assert((uint8)EMythicaJobState::Completed - (uint8)EMythicaJobState::Invalid == 5);
+static_assert((uint8)EMythicaJobState::Completed - (uint8)EMythicaJobState::Invalid == 6);
 
 UMythicaComponent::UMythicaComponent(const FObjectInitializer& ObjectInitializer)
     : Super(ObjectInitializer)
@@ -96,30 +98,64 @@ bool UMythicaComponent::CanRegenerateMesh() const
     return World && World->WorldType == EWorldType::Editor;
 }
 
-void UMythicaComponent::RegenerateMesh()
+EMythicaRegenerateResult UMythicaComponent::RegenerateMesh(bool bForce)
 {
+    FString Fingerprint = LexToString(Mythica::ComputeJobFingerprint(JobDefId.JobDefId, Parameters, GetOwner()->GetActorLocation()));
+
+    UMythicaEditorSubsystem* MythicaEditorSubsystem = GEditor->GetEditorSubsystem<UMythicaEditorSubsystem>();
+
     if (RequestId > 0)
     {
-        QueueRegenerate = true;
-        return;
+        // Inputs may have returned to the state of the in flight job
+        if (!bForce && Fingerprint == RequestFingerprint)
+        {
+            return EMythicaRegenerateResult::Submitted;
+        }
+
+        // Latest request wins, the in flight job is stale
+        MythicaEditorSubsystem->OnJobStateChange.RemoveDynamic(this, &UMythicaComponent::OnJobStateChanged);
+        MythicaEditorSubsystem->CancelJob(RequestId);
+        RequestId = -1;
+        RequestFingerprint.Empty();
     }
 
-    if (!ComponentGuid.IsValid())
+    if (!bForce && Fingerprint == LastJobFingerprint && !GetGeneratedMeshComponents().IsEmpty())
     {
-        ComponentGuid = FGuid::NewGuid();
+        UE_LOG(LogMythica, Verbose, TEXT("Skipping regenerate for %s, inputs unchanged"), *GetName());
+        return EMythicaRegenerateResult::Unchanged;
     }
 
-    UMythicaEditorSubsystem* MythicaEditorSubsystem = GEditor->GetEditorSubsystem<UMythicaEditorSubsystem>();
-    RequestId = MythicaEditorSubsystem->ExecuteJob(JobDefId.JobDefId, Parameters, GetImportPath(), GetOwner()->GetActorLocation(), this);
+    FText Error;
+    RequestId = MythicaEditorSubsystem->ExecuteJob(JobDefId.JobDefId, Parameters, GetImportPath(), GetOwner()->GetActorLocation(), this, Error);
 
-    if (RequestId > 0 && IsRegistered())
+    if (RequestId > 0)
     {
-        MythicaEditorSubsystem->OnJobStateChange.AddDynamic(this, &UMythicaComponent::OnJobStateChanged);
+        RequestFingerprint = Fingerprint;
+
+        if (IsRegistered())
+        {
+            MythicaEditorSubsystem->OnJobStateChange.AddDynamic(this, &UMythicaComponent::OnJobStateChanged);
+        }
+
+        return EMythicaRegenerateResult::Submitted;
     }
+
+    // Don't keep showing the state of a canceled job
+    StateDurations.Add(State, FPlatformTime::Seconds() - StateBeginTime);
+    State = EMythicaJobState::Failed;
+    Message = Error;
+    StateBeginTime = FPlatformTime::Seconds();
+
+    return EMythicaRegenerateResult::Failed;
 }
 
 FString UMythicaComponent::GetImportPath()
 {
+    if (!ComponentGuid.IsValid())
+    {
+        ComponentGuid = FGuid::NewGuid();
+    }
+
     FString ImportFolderClean = ObjectTools::SanitizeObjectName(ToolName);
     FString ImportNameClean = ObjectTools::SanitizeObjectName(ComponentGuid.ToString().Left(IMPORT_NAME_LENGTH));
 
@@ -128,11 +164,23 @@ FString UMythicaComponent::GetImportPath()
 
 bool UMythicaComponent::IsJobProcessing() const
 {
-    return State >= EMythicaJobState::Requesting && State <= EMythicaJobState::Importing;
+    return State >= EMythicaJobState::Scheduled && State <= EMythicaJobState::Importing;
 }
 
 float UMythicaComponent::JobProgressPercent() const
 {
+    // The upload reports its actual progress, the other steps are estimated from their duration
+    double UploadFraction = -1.0;
+    if (State == EMythicaJobState::Requesting && RequestId > 0)
+    {
+        UMythicaEditorSubsystem* MythicaEditorSubsystem = GEditor->GetEditorSubsystem<UMythicaEditorSubsystem>();
+        const FMythicaJob* Job = MythicaEditorSubsystem->FindJob(RequestId);
+        if (Job && Job->UploadSize > 0)
+        {
+            UploadFraction = (double)Job->UploadedBytes / Job->UploadSize;
+        }
+    }
+
     double TotalEstimatedTime = 0.0f;
     double ElapsedTime = 0.0f;
     for (const FMythicaProcessingStep& Step : ProcessingSteps)
@@ -144,6 +192,10 @@ float UMythicaComponent::JobProgressPercent() const
         {
             ElapsedTime += EstimatedTime;
         }
+        else if (Step.State == State && UploadFraction >= 0.0)
+        {
+            ElapsedTime += EstimatedTime * UploadFraction;
+        }
         else if (Step.State == State)
         {
             double TimeInCurrentState = FPlatformTime::Seconds() - StateBeginTime;
@@ -262,6 +314,7 @@ void UMythicaComponent::OnJobDefIdChanged()
 
     State = EMythicaJobState::Invalid;
     StateDurations.Reset();
+    LastJobFingerprint.Empty();
 
     ForceRefreshDetailsViewPanel();
 }
@@ -338,7 +391,7 @@ void UMythicaComponent::OnJobStateChanged(int InRequestId, EMythicaJobState InSt
     State = InState;
     Message = InMessage;
     StateBeginTime = FPlatformTime::Seconds();
-    if (State != EMythicaJobState::Completed && State != EMythicaJobState::Failed)
+    if (State != EMythicaJobState::Completed && State != EMythicaJobState::Failed && State != EMythicaJobState::Canceled)
     {
         return;
     }
@@ -346,17 +399,13 @@ void UMythicaComponent::OnJobStateChanged(int InRequestId, EMythicaJobState InSt
     if (State == EMythicaJobState::Completed)
     {
         UpdateMesh();
+        LastJobFingerprint = RequestFingerprint;
     }
+    RequestFingerprint.Empty();
 
     UMythicaEditorSubsystem* MythicaEditorSubsystem = GEditor->GetEditorSubsystem<UMythicaEditorSubsystem>();
     MythicaEditorSubsystem->OnJobStateChange.RemoveDynamic(this, &UMythicaComponent::OnJobStateChanged);
     RequestId = -1;
-
-    if (QueueRegenerate)
-    {
-        QueueRegenerate = false;
-        RegenerateMesh();
-    }
 }
 
 void UMythicaComponent::UpdateMesh()
@@ -8,6 +8,14 @@
 
 #define MYTHICA_COMPONENT_TAG TEXT("MythicaEditorComp")
 
+UENUM(BlueprintType)
+enum class EMythicaRegenerateResult : uint8
+{
+    Submitted,         // A job is in flight for the current inputs
+    Unchanged,         // Inputs match the last successful job, nothing was submitted
+    Failed             // The job could not be created, the component's message says why
+};
+
 /**
  * FMythicaComponentSettings
  *
@@ -53,10 +61,15 @@ public:
 
     UFUNCTION(BlueprintPure, Category="Mythica|Component")
     bool CanRegenerateMesh() const;
+    /**
+     * Submits a job for the current parameters. Unless forced, the request is skipped when the inputs match
+     * the inputs of the last successful job.
+     */
     UFUNCTION(BlueprintCallable, Category = "Mythica|Component")
-    void RegenerateMesh();
+    EMythicaRegenerateResult RegenerateMesh(bool bForce = false);
     FString GetImportPath();
 
+    int GetRequestId() const { return RequestId; }
     EMythicaJobState GetJobState() const { return State; }
     FText GetJobMessage() const { return Message; }
     bool IsJobProcessing() const;
@@ -120,11 +133,16 @@ private:
     UPROPERTY(VisibleAnywhere, DuplicateTransient, meta = (EditCondition = "false", EditConditionHides))
     double StateBeginTime = 0.0f;
 
+    UPROPERTY(Transient, DuplicateTransient)
+    FTimerHandle DelayRegenerateHandle;
+
+    /** Fingerprint of the inputs used by the last successful job */
     UPROPERTY(VisibleAnywhere, DuplicateTransient, meta = (EditCondition = "false", EditConditionHides))
-    bool QueueRegenerate = false;
+    FString LastJobFingerprint = FString();
 
+    /** Fingerprint of the inputs used by the in flight job */
     UPROPERTY(Transient, DuplicateTransient)
-    FTimerHandle DelayRegenerateHandle;
+    FString RequestFingerprint = FString();
 
     UPROPERTY(VisibleAnywhere, meta = (EditCondition = "false", EditConditionHides))
     TMap<EMythicaJobState, double> StateDurations = TMap<EMythicaJobState, double>();
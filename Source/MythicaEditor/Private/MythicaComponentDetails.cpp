@@ -129,7 +129,7 @@ void FMythicaComponentDetails::CustomizeDetails(IDetailLayoutBuilder& DetailBuil
                                         {
                                             if (ComponentWeak.IsValid())
                                             {
-                                                ComponentWeak->RegenerateMesh();
+                                                ComponentWeak->RegenerateMesh(true);
                                             }
                                             return FReply::Handled();
                                         })
@@ -70,4 +70,84 @@ public:
 
     UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = Settings)
     float JobTimeoutSeconds = 120.0f;
+
+    /** Number of jobs exported, uploaded and processed at the same time, additional jobs wait in a queue */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = Settings, meta = (ClampMin = "1"))
+    int32 MaxConcurrentJobs = 4;
+
+    /** Number of input files uploaded at the same time across all jobs */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = Settings, meta = (ClampMin = "1"))
+    int32 MaxConcurrentUploads = 4;
+
+    /** Number of times a failed input upload is retried before the job fails */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = Settings, meta = (ClampMin = "0"))
+    int32 UploadRetryCount = 3;
+
+    /** Delay before the first retry of a failed upload, doubled for every following retry */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = Settings, meta = (ClampMin = "0", Units = "Seconds"))
+    float UploadRetryDelaySeconds = 1.0f;
+
+    /** Input files of at least this size are uploaded in parts that resume where they left off after a failure */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = Settings, meta = (ClampMin = "1", Units = "Megabytes"))
+    int32 ResumableUploadThresholdMB = 64;
+
+    /** Size of the parts of a resumable upload */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = Settings, meta = (ClampMin = "1", Units = "Megabytes"))
+    int32 UploadPartSizeMB = 8;
+
+    /** Gzip input files on a worker thread before uploading them, falls back to uncompressed uploads if the service rejects them */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = Settings)
+    bool CompressUploads = false;
+
+    /** Compression level from 1 (fastest) to 9 (smallest) */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = Settings, meta = (ClampMin = "1", ClampMax = "9", EditCondition = "CompressUploads"))
+    int32 UploadCompressionLevel = 6;
+
+    /** Number of queued jobs at which the queue reports back-pressure */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = Settings, meta = (ClampMin = "1"))
+    int32 JobQueueSaturationThreshold = 32;
+
+    /** Reuse the results of previous jobs with identical inputs instead of sending them to the server */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = Cache)
+    bool EnableResultCache = true;
+
+    /** Size budget of the local result cache, least recently used results are evicted first */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = Cache, meta = (ClampMin = "0", EditCondition = "EnableResultCache"))
+    int32 ResultCacheSizeMB = 2048;
+
+    /** Share results with other editors through the derived data cache (local, shared or cloud) */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = Cache, meta = (EditCondition = "EnableResultCache"))
+    bool EnableSharedResultCache = true;
+
+    /** Reuse the server file ids of inputs that were already uploaded instead of exporting and uploading them again */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = Cache)
+    bool EnableUploadCache = true;
+
+    /** Time after which an uploaded input is uploaded again, should stay below the server's retention of uploaded files */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = Cache, meta = (ClampMin = "1", Units = "Minutes", EditCondition = "EnableUploadCache"))
+    int32 UploadCacheExpiryMinutes = 60;
+
+    /** Keep the exports of Mesh inputs and the converted static meshes of World and Volume inputs, unchanged meshes are reused without exporting them again */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = Cache)
+    bool EnableExportLayerCache = true;
+
+    /** Time after which an unused cached mesh export is deleted */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = Cache, meta = (ClampMin = "1", Units = "Days", EditCondition = "EnableExportLayerCache"))
+    int32 ExportLayerCacheExpiryDays = 7;
+
+    /** Size of the regions a world partition regenerate loads at a time */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = WorldPartition, meta = (ClampMin = "100", Units = "cm"))
+    float WorldPartitionRegionSize = 51200.0f;
+
+    /** Regions that exceed the memory ceiling are split until they reach this size */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = WorldPartition, meta = (ClampMin = "100", Units = "cm"))
+    float WorldPartitionMinRegionSize = 6400.0f;
+
+    /** Extra distance loaded around a region so inputs in neighbouring cells are available */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = WorldPartition, meta = (ClampMin = "0", Units = "cm"))
+    float WorldPartitionLoadPadding = 6400.0f;
+
+    /** Used memory above which a loaded region is split into smaller regions */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = WorldPartition, meta = (ClampMin = "1024"))
+    int32 WorldPartitionMemoryCeilingMB = 16384;
 };
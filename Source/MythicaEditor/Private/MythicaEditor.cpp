@@ -3,11 +3,14 @@
 #include "MythicaEditor.h"
 
 #include "Editor/UnrealEdEngine.h"
+#include "HAL/IConsoleManager.h"
 #include "LevelEditor.h"
 #include "Libraries/MythicaEditorUtilityLibrary.h"
 #include "MythicaEditorStyle.h"
+#include "MythicaEditorSubsystem.h"
 #include "MythicaComponentDetails.h"
 #include "MythicaParametersDetails.h"
+#include "MythicaUSDUtil.h"
 #include "PropertyEditorModule.h"
 #include "UnrealEdGlobals.h"
 #include "ToolMenu.h"
@@ -44,6 +47,71 @@ static void OpenMythicaSceneHelper_Clicked()
     UMythicaEditorUtilityLibrary::OpenSceneHelper();
 }
 
+static void RegenerateAllComponents_Clicked()
+{
+    UMythicaEditorSubsystem* MythicaEditorSubsystem = GEditor->GetEditorSubsystem<UMythicaEditorSubsystem>();
+    if (MythicaEditorSubsystem->IsRegeneratingAllComponents())
+    {
+        MythicaEditorSubsystem->CancelRegenerateAllComponents();
+    }
+    else
+    {
+        MythicaEditorSubsystem->RegenerateAllComponents();
+    }
+}
+
+static bool CanRegenerateAllComponents()
+{
+    UMythicaEditorSubsystem* MythicaEditorSubsystem = GEditor->GetEditorSubsystem<UMythicaEditorSubsystem>();
+    return HasNoPlayWorld() && MythicaEditorSubsystem->CanGenerateMeshes();
+}
+
+static FAutoConsoleCommand RegenerateAllCommand(
+    TEXT("Mythica.RegenerateAll"),
+    TEXT("Regenerates every Mythica component in the level ordered by input dependencies. Pass 'force' to regenerate components with unchanged inputs."),
+    FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+    {
+        bool bForce = Args.Contains(TEXT("force"));
+        GEditor->GetEditorSubsystem<UMythicaEditorSubsystem>()->RegenerateAllComponents(bForce);
+    })
+);
+
+static FAutoConsoleCommand RegenerateWorldPartitionCommand(
+    TEXT("Mythica.RegenerateWorldPartition"),
+    TEXT("Regenerates every Mythica component of a world partition map one region at a time, saving and unloading each region before moving on. Pass 'force' to regenerate components with unchanged inputs."),
+    FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+    {
+        bool bForce = Args.Contains(TEXT("force"));
+        GEditor->GetEditorSubsystem<UMythicaEditorSubsystem>()->RegenerateWorldPartition(bForce);
+    })
+);
+
+static FAutoConsoleCommand BenchmarkCompactMeshCommand(
+    TEXT("Mythica.BenchmarkCompactMesh"),
+    TEXT("Compares the size and encode/decode time of the compact mesh format with USDZ for the given static mesh paths and checks the round trip error."),
+    FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+    {
+        int32 NumFailed = 0;
+        for (const FString& MeshPath : Args)
+        {
+            UStaticMesh* Mesh = LoadObject<UStaticMesh>(nullptr, *MeshPath);
+            if (!Mesh)
+            {
+                UE_LOG(LogMythicaEditor, Error, TEXT("Static mesh %s not found"), *MeshPath);
+                NumFailed++;
+                continue;
+            }
+
+            if (!Mythica::BenchmarkCompactMesh(Mesh))
+            {
+                NumFailed++;
+            }
+        }
+
+        UE_LOG(LogMythicaEditor, Display, TEXT("Benchmarked %d meshes, %d failed"), Args.Num(), NumFailed);
+    })
+);
+
 static TSharedRef<SWidget> GetMythicaHubDropDown()
 {
     FMenuBuilder MenuBuilder(true, nullptr);
@@ -75,6 +143,28 @@ static TSharedRef<SWidget> GetMythicaHubDropDown()
 
     MenuBuilder.EndSection();
 
+    MenuBuilder.BeginSection("Jobs", LOCTEXT("HubJobsSectionText", "Jobs"));
+
+    MenuBuilder.AddMenuEntry(
+        TAttribute<FText>::CreateLambda([]()
+        {
+            UMythicaEditorSubsystem* MythicaEditorSubsystem = GEditor->GetEditorSubsystem<UMythicaEditorSubsystem>();
+            return MythicaEditorSubsystem->IsRegeneratingAllComponents()
+                ? LOCTEXT("CancelRegenerateAllButton", "Cancel Regenerate All")
+                : LOCTEXT("RegenerateAllButton", "Regenerate All Components");
+        }),
+        LOCTEXT("RegenerateAllDescription", "Regenerates every Mythica component in the level. Components that take another component's actor as input run after it."),
+        FSlateIcon(FMythicaEditorStyle::GetStyleSetName(), "MythicaEditor.MythicaLogo"),
+        FUIAction(
+            FExecuteAction::CreateStatic(&RegenerateAllComponents_Clicked),
+            FCanExecuteAction::CreateStatic(&CanRegenerateAllComponents),
+            FIsActionChecked(),
+            FIsActionButtonVisible::CreateStatic(&HasNoPlayWorld)
+        )
+    );
+
+    MenuBuilder.EndSection();
+
     return MenuBuilder.MakeWidget();
 }
 
@@ -6,6 +6,7 @@
 #include "Engine/Texture2D.h"
 #include "FileHelpers.h"
 #include "FileUtilities/ZipArchiveReader.h"
+#include "Async/Async.h"
 #include "HAL/FileManager.h"
 #include "HAL/PlatformFileManager.h"
 #include "HttpModule.h"
@@ -14,9 +15,18 @@
 #include "ImageUtils.h"
 #include "Interfaces/IPluginManager.h"
 #include "Kismet\KismetSystemLibrary.h"
+#include "Jobs/MythicaBulkRegenerate.h"
+#include "Jobs/MythicaJobFingerprint.h"
+#include "Jobs/MythicaJobSubsystem.h"
+#include "Jobs/MythicaSharedResultCache.h"
+#include "Jobs/MythicaUploadCompression.h"
+#include "Jobs/MythicaUploadStream.h"
+#include "Jobs/MythicaVariantBatch.h"
+#include "Jobs/MythicaWorldPartitionRegenerate.h"
 #include "LevelEditor.h"
 #include "Misc/Base64.h"
 #include "Misc/ConfigCacheIni.h"
+#include "Misc/EngineVersionComparison.h"
 #include "Misc/FileHelper.h"
 #include "MythicaComponent.h"
 #include "MythicaDeveloperSettings.h"
@@ -52,6 +62,11 @@ static bool JobWaitingForStreamItems(EMythicaJobState State)
     return State == EMythicaJobState::Queued || State == EMythicaJobState::Processing;
 }
 
+static bool JobFinished(EMythicaJobState State)
+{
+    return State == EMythicaJobState::Completed || State == EMythicaJobState::Failed || State == EMythicaJobState::Canceled;
+}
+
 static bool CanImportAsset(const FString& FilePath)
 {
     FString Extension = FPaths::GetExtension(FilePath);
@@ -87,6 +102,21 @@ static FString MakeUniquePath(const FString& AbsolutePath)
     return UniquePath;
 }
 
+static FMythicaMeshExportOptions MakeMeshExportOptions(const FMythicaParameterFileSettings& Settings)
+{
+    FMythicaMeshExportOptions Options;
+    Options.Profile = Settings.ExportProfile;
+    Options.LOD = Settings.MeshLOD;
+    Options.TriangleBudget = Settings.MeshTriangleBudget;
+    Options.Format = Settings.ExportFormat;
+    return Options;
+}
+
+static FString MakeMeshExportFileName(const FMythicaParameterFileSettings& Settings)
+{
+    return FString::Printf(TEXT("Mesh.%s"), Mythica::GetExportExtension(Settings.ExportFormat));
+}
+
 bool FMythicaAssetVersion::operator<(const FMythicaAssetVersion& Other) const
 {
     return Major < Other.Major
@@ -134,12 +164,21 @@ void UMythicaEditorSubsystem::Initialize(FSubsystemCollectionBase& Collection)
     CreateSession();
 
     LoadInstalledAssetList();
+
+    ResultCache.Initialize();
+
+    UploadCache.Initialize();
+    UploadCache.Trim(GetDefault<UMythicaDeveloperSettings>()->UploadCacheExpiryMinutes * 60.0);
+
+    Mythica::TrimExportLayerCache(GetDefault<UMythicaDeveloperSettings>()->ExportLayerCacheExpiryDays * 24.0 * 60.0 * 60.0);
 }
 
 void UMythicaEditorSubsystem::Deinitialize()
 {
     Super::Deinitialize();
 
+    ResultCache.Deinitialize();
+
     if (FModuleManager::Get().IsModuleLoaded(TEXT("LevelEditor")))
     {
         FLevelEditorModule& LevelEditorModule = FModuleManager::LoadModuleChecked<FLevelEditorModule>(TEXT("LevelEditor"));
@@ -291,7 +330,12 @@ FMythicaStats UMythicaEditorSubsystem::GetStats()
 EMythicaJobState UMythicaEditorSubsystem::GetRequestState(int RequestId)
 {
     FMythicaJob* RequestData = Jobs.Find(RequestId);
-    return RequestData ? RequestData->State : EMythicaJobState::Invalid;
+    if (!RequestData)
+    {
+        return EMythicaJobState::Invalid;
+    }
+
+    return RequestData->Canceled ? EMythicaJobState::Canceled : RequestData->State;
 }
 
 FString UMythicaEditorSubsystem::GetImportDirectory(int RequestId)
@@ -300,6 +344,11 @@ FString UMythicaEditorSubsystem::GetImportDirectory(int RequestId)
     return RequestData ? RequestData->ImportDirectory : FString();
 }
 
+const FMythicaJob* UMythicaEditorSubsystem::FindJob(int RequestId) const
+{
+    return Jobs.Find(RequestId);
+}
+
 void UMythicaEditorSubsystem::CreateSession()
 {
     if (SessionState != EMythicaSessionState::None && SessionState != EMythicaSessionState::SessionFailed)
@@ -359,6 +408,7 @@ void UMythicaEditorSubsystem::OnCreateSessionResponse(FHttpRequestPtr Request, F
 
     AuthToken = Token;
 
+    UploadCompressionSupported = true;
     SetSessionState(EMythicaSessionState::SessionCreated);
 
     CreateSessionWebSocket();
@@ -570,6 +620,8 @@ void UMythicaEditorSubsystem::OnDownloadInfoResponse(FHttpRequestPtr Request, FH
     DownloadRequest->OnProcessRequestComplete().BindLambda(Callback);
 
     DownloadRequest->ProcessRequest();
+
+    RequestData->PendingRequest = DownloadRequest;
 }
 
 struct FFileImportData
@@ -1078,14 +1130,14 @@ void UMythicaEditorSubsystem::OnAssetGroupResponse(FHttpRequestPtr Request, FHtt
     OnFavoriteAssetsUpdated.Broadcast();
 }
 
-bool UMythicaEditorSubsystem::PrepareInputFiles(const FMythicaParameters& Params, TMap<int, FString>& InputFiles, FString& ExportDirectory, const FVector& Origin)
+bool UMythicaEditorSubsystem::PrepareInputFiles(const FMythicaParameters& Params, TArray<FMythicaInputExport>& OutExports, FString& ExportDirectory, const FVector& Origin, const TMap<int, FString>& UploadedInputs, FMythicaExportStats& OutStats)
 {
     FString DesiredDirectory = FPaths::Combine(FPaths::ProjectIntermediateDir(), TEXT("MythicaCache"), TEXT("ExportCache"), TEXT("Export"));
     ExportDirectory = MakeUniquePath(DesiredDirectory);
 
     for (int i = 0; i < Params.Parameters.Num(); i++)
     {
-        if (Params.Parameters[i].Type != EMythicaParameterType::File)
+        if (Params.Parameters[i].Type != EMythicaParameterType::File || UploadedInputs.Contains(i))
         {
             continue;
         }
@@ -1098,15 +1150,16 @@ bool UMythicaEditorSubsystem::PrepareInputFiles(const FMythicaParameters& Params
                 continue;
             }
 
-            FString FilePath = FPaths::Combine(ExportDirectory, FString::Format(TEXT("Input{0}"), { i }), "Mesh.usdz");
-            bool Success = Mythica::ExportMesh(Input.Mesh, FilePath);
+            FString FilePath = FPaths::Combine(ExportDirectory, FString::Format(TEXT("Input{0}"), { i }), MakeMeshExportFileName(Input.Settings));
+            FMythicaExportWriter Writer;
+            bool Success = Mythica::ExportMesh(Input.Mesh, FilePath, MakeMeshExportOptions(Input.Settings), Writer, &OutStats);
             if (!Success)
             {
                 UE_LOG(LogMythica, Error, TEXT("Failed to export mesh %s"), *Input.Mesh->GetName());
                 return false;
             }
 
-            InputFiles.Add(i, FilePath);
+            OutExports.Add(FMythicaInputExport{ i, FilePath, MoveTemp(Writer) });
         }
         else if (Input.Type == EMythicaInputType::World)
         {
@@ -1117,15 +1170,16 @@ bool UMythicaEditorSubsystem::PrepareInputFiles(const FMythicaParameters& Params
                 continue;
             }
 
-            FString FilePath = FPaths::Combine(ExportDirectory, FString::Format(TEXT("Input{0}"), { i }), "Mesh.usdz");
-            bool Success = Mythica::ExportActors(Actors, FilePath, Origin, Input.Settings.TransformType);
+            FString FilePath = FPaths::Combine(ExportDirectory, FString::Format(TEXT("Input{0}"), { i }), MakeMeshExportFileName(Input.Settings));
+            FMythicaExportWriter Writer;
+            bool Success = Mythica::ExportActors(Actors, Origin, Input.Settings.TransformType, MakeMeshExportOptions(Input.Settings), Writer, &OutStats);
             if (!Success)
             {
                 UE_LOG(LogMythica, Error, TEXT("Failed to export actors"));
                 return false;
             }
 
-            InputFiles.Add(i, FilePath);
+            OutExports.Add(FMythicaInputExport{ i, FilePath, MoveTemp(Writer) });
         }
         else if (Input.Type == EMythicaInputType::Spline)
         {
@@ -1135,14 +1189,15 @@ bool UMythicaEditorSubsystem::PrepareInputFiles(const FMythicaParameters& Params
             }
 
             FString FilePath = FPaths::Combine(ExportDirectory, FString::Format(TEXT("Input{0}"), { i }), "Mesh.usdz");
-            bool Success = Mythica::ExportSpline(Input.SplineActor, FilePath, Origin, Input.Settings.TransformType);
+            FMythicaExportWriter Writer;
+            bool Success = Mythica::ExportSpline(Input.SplineActor, Origin, Input.Settings.TransformType, Writer);
             if (!Success)
             {
                 UE_LOG(LogMythica, Error, TEXT("Failed to export spline"));
                 return false;
             }
 
-            InputFiles.Add(i, FilePath);
+            OutExports.Add(FMythicaInputExport{ i, FilePath, MoveTemp(Writer) });
         }
         else if (Input.Type == EMythicaInputType::Volume)
         {
@@ -1158,253 +1213,1497 @@ bool UMythicaEditorSubsystem::PrepareInputFiles(const FMythicaParameters& Params
                 continue;
             }
 
-            FString FilePath = FPaths::Combine(ExportDirectory, FString::Format(TEXT("Input{0}"), { i }), "Mesh.usdz");
-            bool Success = Mythica::ExportActors(Actors, FilePath, Origin, Input.Settings.TransformType);
+            FString FilePath = FPaths::Combine(ExportDirectory, FString::Format(TEXT("Input{0}"), { i }), MakeMeshExportFileName(Input.Settings));
+            FMythicaExportWriter Writer;
+            bool Success = Mythica::ExportActors(Actors, Origin, Input.Settings.TransformType, MakeMeshExportOptions(Input.Settings), Writer, &OutStats);
             if (!Success)
             {
                 UE_LOG(LogMythica, Error, TEXT("Failed to export volume actors"));
                 return false;
             }
 
-            InputFiles.Add(i, FilePath);
+            OutExports.Add(FMythicaInputExport{ i, FilePath, MoveTemp(Writer) });
         }
     }
 
     return true;
 }
 
-void UMythicaEditorSubsystem::UploadInputFiles(int RequestId, const TMap<int, FString>& InputFiles)
+void UMythicaEditorSubsystem::OnInputFileExported(int RequestId, int InputIndex, const FString& FilePath, const FMythicaUploadData& Data, const FString& UploadKey)
+{
+    // The job ended while the input was packaged, its export directory is already gone
+    FMythicaJob* RequestData = Jobs.Find(RequestId);
+    if (!RequestData || JobFinished(RequestData->State))
+    {
+        if (MYTHICA_CLEAN_TEMP_FILES)
+        {
+            IFileManager::Get().DeleteDirectory(*FPaths::GetPath(FilePath), false, true);
+        }
+        return;
+    }
+
+    if (!Data.IsValid())
+    {
+        UE_LOG(LogMythica, Error, TEXT("Failed to package input file %s"), *FilePath);
+        SetJobState(RequestId, EMythicaJobState::Failed, FText::FromString("Failed to prepare input files"));
+        return;
+    }
+
+    // Inputs that exported to an already uploaded file skip the upload
+    if (!UploadKey.IsEmpty())
+    {
+        RequestData->InputUploadKeys.FindOrAdd(InputIndex).Add(UploadKey);
+
+        const UMythicaDeveloperSettings* Settings = GetDefault<UMythicaDeveloperSettings>();
+        FString FileId;
+        if (UploadCache.FindFileId(UploadKey, Settings->GetServiceURL(), Settings->UploadCacheExpiryMinutes * 60.0, FileId))
+        {
+            RequestData->InputFileIds.SetNum(FMath::Max(RequestData->InputFileIds.Num(), InputIndex + 1), false);
+            RequestData->InputFileIds[InputIndex] = FileId;
+
+            RequestData->PendingUploads--;
+            if (RequestData->PendingUploads <= 0)
+            {
+                OnInputFilesUploaded(RequestId);
+            }
+            return;
+        }
+    }
+
+    AddFileUpload(RequestId, InputIndex, FilePath, Data);
+}
+
+void UMythicaEditorSubsystem::AddFileUpload(int RequestId, int InputIndex, const FString& FilePath, const FMythicaUploadData& Data)
+{
+    const UMythicaDeveloperSettings* Settings = GetDefault<UMythicaDeveloperSettings>();
+
+    // Every file is uploaded on its own so a failure only retries that file
+    int UploadId = NextUploadId++;
+
+    FMythicaFileUpload& Upload = FileUploads.Add(UploadId);
+    Upload.RequestId = RequestId;
+    Upload.InputIndex = InputIndex;
+    Upload.FilePath = FilePath;
+    Upload.Data = Data;
+    Upload.UploadData = Data;
+    Upload.Size = Data->Num();
+
+    FMythicaJob& Job = Jobs[RequestId];
+    if (Job.UploadMetrics.Files == 0)
+    {
+        Job.UploadStartTime = FPlatformTime::Seconds();
+    }
+    Job.UploadSize += Upload.Size;
+    Job.UploadMetrics.Files++;
+    Job.UploadMetrics.RawBytes += Upload.Size;
+
+    // Compressed files join the queue once they are ready
+    if (Settings->CompressUploads && UploadCompressionSupported)
+    {
+        CompressFileUpload(UploadId);
+    }
+    else
+    {
+        QueuedUploadIds.Add(UploadId);
+        StartQueuedUploads();
+    }
+}
+
+void UMythicaEditorSubsystem::CompressFileUpload(int UploadId)
+{
+    const FMythicaFileUpload& Upload = FileUploads[UploadId];
+
+    FMythicaUploadData Data = Upload.Data;
+    int32 Level = GetDefault<UMythicaDeveloperSettings>()->UploadCompressionLevel;
+
+    TWeakObjectPtr<UMythicaEditorSubsystem> WeakThis(this);
+    Async(EAsyncExecution::ThreadPool, [WeakThis, UploadId, Data, Level]()
+    {
+        double StartTime = FPlatformTime::Seconds();
+
+        TArray64<uint8> Compressed;
+        FMythicaUploadData CompressedData;
+        if (Mythica::GzipData(*Data, Level, Compressed))
+        {
+            CompressedData = MakeShared<TArray64<uint8>, ESPMode::ThreadSafe>(MoveTemp(Compressed));
+        }
+
+        double Seconds = FPlatformTime::Seconds() - StartTime;
+
+        AsyncTask(ENamedThreads::GameThread, [WeakThis, UploadId, CompressedData, Seconds]()
+        {
+            if (UMythicaEditorSubsystem* Subsystem = WeakThis.Get())
+            {
+                Subsystem->OnFileUploadCompressed(UploadId, CompressedData, Seconds);
+            }
+        });
+    });
+}
+
+void UMythicaEditorSubsystem::OnFileUploadCompressed(int UploadId, const FMythicaUploadData& CompressedData, double Seconds)
+{
+    // Canceled along with its job while compressing
+    FMythicaFileUpload* Upload = FileUploads.Find(UploadId);
+    if (!Upload)
+    {
+        return;
+    }
+
+    FMythicaJob& Job = Jobs[Upload->RequestId];
+    Job.UploadMetrics.CompressSeconds += Seconds;
+
+    // Send the file as is if compression failed or didn't make it smaller
+    if (CompressedData.IsValid() && CompressedData->Num() < Upload->Data->Num())
+    {
+        Upload->UploadData = CompressedData;
+        Upload->ContentEncoding = Mythica::UploadContentEncoding;
+
+        Job.UploadSize += CompressedData->Num() - Upload->Size;
+        Upload->Size = CompressedData->Num();
+    }
+
+    QueuedUploadIds.Add(UploadId);
+    StartQueuedUploads();
+}
+
+void UMythicaEditorSubsystem::StartQueuedUploads()
+{
+    const UMythicaDeveloperSettings* Settings = GetDefault<UMythicaDeveloperSettings>();
+
+    while (ActiveUploads < Settings->MaxConcurrentUploads && !QueuedUploadIds.IsEmpty())
+    {
+        int UploadId = QueuedUploadIds[0];
+        QueuedUploadIds.RemoveAt(0);
+
+        StartFileUpload(UploadId);
+    }
+}
+
+void UMythicaEditorSubsystem::StartFileUpload(int UploadId)
 {
+    FMythicaFileUpload* Upload = FileUploads.Find(UploadId);
+    if (!Upload)
+    {
+        return;
+    }
+
     // Construct the upload request
     const UMythicaDeveloperSettings* Settings = GetDefault<UMythicaDeveloperSettings>();
 
+    // Large files go in parts so a dropped connection only resends the current part
+    if (Upload->Size >= (int64)Settings->ResumableUploadThresholdMB * 1024 * 1024)
+    {
+        ActiveUploads++;
+        StartResumableUpload(UploadId);
+        return;
+    }
+
     FString Url = FString::Printf(TEXT("%s/v1/upload/store"), *Settings->GetServiceURL());
 
-    auto Callback = [this, RequestId, InputFiles](FHttpRequestPtr Request, FHttpResponsePtr Response, bool bConnectedSuccessfully)
+    auto Callback = [this, UploadId](FHttpRequestPtr Request, FHttpResponsePtr Response, bool bConnectedSuccessfully)
     {
-        OnUploadInputFilesResponse(Request, Response, bConnectedSuccessfully, RequestId, InputFiles);
+        OnFileUploadResponse(Request, Response, bConnectedSuccessfully, UploadId);
     };
 
-    FString NewLine = "\r\n";
     FString Boundary = "---------------------------" + FString::FromInt(FDateTime::Now().GetTicks());
 
+    // The body references the packaged input instead of copying it into the request
+    TSharedRef<FMythicaMultipartStream, ESPMode::ThreadSafe> Body = MakeShared<FMythicaMultipartStream, ESPMode::ThreadSafe>(Boundary);
+    Body->AddData(TEXT("files"), Upload->UploadData, FPaths::GetCleanFilename(Upload->FilePath), Upload->ContentEncoding);
+    Body->Finalize();
+
     TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
     Request->SetURL(Url);
     Request->SetVerb("POST");
     Request->SetHeader("Authorization", FString::Printf(TEXT("Bearer %s"), *AuthToken));
-    Request->SetHeader(TEXT("Content-Type"), TEXT("multipart/form-data; boundary =" + Boundary));
+    Request->SetHeader(TEXT("Content-Type"), Body->GetContentType());
+    Request->SetContentFromStream(Body);
     Request->OnProcessRequestComplete().BindLambda(Callback);
+#if UE_VERSION_OLDER_THAN(5, 4, 0)
+    Request->OnRequestProgress().BindLambda([this, UploadId](FHttpRequestPtr, int32 BytesSent, int32)
+    {
+        OnFileUploadProgress(UploadId, (uint64)BytesSent);
+    });
+#else
+    Request->OnRequestProgress64().BindLambda([this, UploadId](FHttpRequestPtr, uint64 BytesSent, uint64)
+    {
+        OnFileUploadProgress(UploadId, BytesSent);
+    });
+#endif
 
-    // Construct the payload
-    TArray<uint8> RequestBodyBytes;
+    Upload->Request = Request;
+    ActiveUploads++;
 
-    for (TMap<int, FString>::TConstIterator It(InputFiles); It; ++It)
-    {
-        const FString& File = It.Value();
+    // Send the request
+    Request->ProcessRequest();
+}
 
-        TArray<uint8> FileBytes;
-        bool PackageWritten = FFileHelper::LoadFileToArray(FileBytes, *File);
+void UMythicaEditorSubsystem::RetryFileUpload(int UploadId)
+{
+    FMythicaFileUpload* Upload = FileUploads.Find(UploadId);
+    if (!Upload)
+    {
+        return;
+    }
 
-        FString RequestContent;
-        RequestContent += "--" + Boundary + NewLine;
-        RequestContent += "Content-Disposition: form-data; name=\"files\"; filename=\"" + FPaths::GetCleanFilename(File) + "\"" + NewLine;
-        RequestContent += "Content-Type: application/octet-stream" + NewLine + NewLine;
+    Upload->RetryTimer.Invalidate();
+    QueuedUploadIds.Add(UploadId);
+    StartQueuedUploads();
+}
 
-        RequestBodyBytes.Append((uint8*)TCHAR_TO_ANSI(*RequestContent), RequestContent.Len());
-        RequestBodyBytes.Append(FileBytes);
-        RequestBodyBytes.Append((uint8*)TCHAR_TO_ANSI(*NewLine), NewLine.Len());
+void UMythicaEditorSubsystem::OnFileUploadProgress(int UploadId, uint64 BytesSent)
+{
+    FMythicaFileUpload* Upload = FileUploads.Find(UploadId);
+    if (!Upload)
+    {
+        return;
     }
 
-    FString ClosingBoundary = "--" + Boundary + "--" + NewLine;
-    RequestBodyBytes.Append((uint8*)TCHAR_TO_ANSI(*ClosingBoundary), ClosingBoundary.Len());
+    FMythicaJob* RequestData = Jobs.Find(Upload->RequestId);
+    if (!RequestData || RequestData->State == EMythicaJobState::Canceled)
+    {
+        return;
+    }
 
-    Request->SetContent(RequestBodyBytes);
+    // The body includes the multipart headers, only count the file bytes. Parts of a resumable upload start at its offset.
+    int64 SentBytes = FMath::Min(Upload->Offset + (int64)BytesSent, Upload->Size);
+    RequestData->UploadedBytes = FMath::Clamp<int64>(RequestData->UploadedBytes + SentBytes - Upload->SentBytes, 0, RequestData->UploadSize);
+    Upload->SentBytes = SentBytes;
 
-    // Send the request
-    Request->ProcessRequest();
+    OnJobUploadProgress.Broadcast(Upload->RequestId, RequestData->UploadedBytes, RequestData->UploadSize);
 }
 
-void UMythicaEditorSubsystem::OnUploadInputFilesResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, int RequestId, const TMap<int, FString>& InputFiles)
+void UMythicaEditorSubsystem::OnFileUploadResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, int UploadId)
 {
-    FMythicaJob* RequestData = Jobs.Find(RequestId);
-    if (!RequestData)
+    ReleaseUploadSlot();
+
+    FMythicaFileUpload* Upload = FindActiveFileUpload(UploadId);
+    if (!Upload)
     {
         return;
     }
 
+    FString FileId;
+    FString Error;
     if (!bWasSuccessful || !Response.IsValid())
     {
-        UE_LOG(LogMythica, Error, TEXT("Failed to upload inputs"));
-        SetJobState(RequestId, EMythicaJobState::Failed, FText::FromString("Failed to upload input data 1"));
-        return;
+        Error = TEXT("connection failed");
     }
+    else if (!EHttpResponseCodes::IsOk(Response->GetResponseCode()))
+    {
+        Error = FString::Printf(TEXT("status %d"), Response->GetResponseCode());
+    }
+    else
+    {
+        TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Response->GetContentAsString());
 
-    FString ResponseContent = Response->GetContentAsString();
-    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(ResponseContent);
+        TSharedPtr<FJsonObject> JsonObject;
+        const TArray<TSharedPtr<FJsonValue>>* Files = nullptr;
+        if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid()
+            || !JsonObject->TryGetArrayField(TEXT("files"), Files) || Files->Num() != 1)
+        {
+            Error = TEXT("unexpected response");
+        }
+        else if (!(*Files)[0]->AsObject()->TryGetStringField(TEXT("file_id"), FileId) || FileId.IsEmpty())
+        {
+            Error = TEXT("missing file id");
+        }
+    }
 
-    TSharedPtr<FJsonObject> JsonObject;
-    if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
+    if (DisableUploadCompression(UploadId, Response))
     {
-        UE_LOG(LogMythica, Error, TEXT("Failed to parse upload inputs JSON string"));
-        SetJobState(RequestId, EMythicaJobState::Failed, FText::FromString("Failed to upload input data 2"));
         return;
     }
 
-    TArray<TSharedPtr<FJsonValue>> Files = JsonObject->GetArrayField(TEXT("files"));
-    if (Files.Num() != InputFiles.Num())
+    if (!Error.IsEmpty())
     {
-        UE_LOG(LogMythica, Error, TEXT("Unexpected number of uploaded files"));
-        SetJobState(RequestId, EMythicaJobState::Failed, FText::FromString("Failed to upload input data 3"));
+        FailFileUpload(UploadId, Error);
         return;
     }
 
-    TArray<FString> InputFileIds;
+    FinishFileUpload(UploadId, FileId);
+}
 
-    int FileIndex = 0;
-    for (TMap<int, FString>::TConstIterator It(InputFiles); It; ++It, ++FileIndex)
+void UMythicaEditorSubsystem::StartResumableUpload(int UploadId)
+{
+    FMythicaFileUpload* Upload = FileUploads.Find(UploadId);
+    if (!Upload)
     {
-        int InputIndex = It.Key();
-        const FString& File = It.Value();
+        return;
+    }
 
-        TSharedPtr<FJsonObject> FileObject = Files[FileIndex]->AsObject();
-        FString FileId = FileObject->GetStringField(TEXT("file_id"));
+    const UMythicaDeveloperSettings* Settings = GetDefault<UMythicaDeveloperSettings>();
 
-        InputFileIds.SetNum(InputIndex + 1, false);
-        InputFileIds[InputIndex] = FileId;
-    }
+    auto Callback = [this, UploadId](FHttpRequestPtr Request, FHttpResponsePtr Response, bool bConnectedSuccessfully)
+    {
+        OnResumableUploadStatus(Request, Response, bConnectedSuccessfully, UploadId);
+    };
 
-    RequestData->InputFileIds = InputFileIds;
+    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
+    Request->SetHeader("Authorization", FString::Printf(TEXT("Bearer %s"), *AuthToken));
+    Request->OnProcessRequestComplete().BindLambda(Callback);
 
-    SendJobRequest(RequestId);
-}
+    if (Upload->ResumableUploadId.IsEmpty())
+    {
+        // Open an upload session for the file
+        TSharedPtr<FJsonObject> JsonObject = MakeShareable(new FJsonObject);
+        JsonObject->SetStringField(TEXT("file_name"), FPaths::GetCleanFilename(Upload->FilePath));
+        JsonObject->SetNumberField(TEXT("size"), (double)Upload->Size);
+        if (!Upload->ContentEncoding.IsEmpty())
+        {
+            JsonObject->SetStringField(TEXT("content_encoding"), Upload->ContentEncoding);
+        }
 
-int UMythicaEditorSubsystem::ExecuteJob(
-    const FString& JobDefId, 
-    const FMythicaParameters& Params, 
-    const FString& ImportPath,
-    const FVector& Origin,
-    UMythicaComponent* ExecutingComp
-) {
-    if (SessionState != EMythicaSessionState::SessionCreated)
+        FString RequestContent;
+        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&RequestContent);
+        FJsonSerializer::Serialize(JsonObject.ToSharedRef(), Writer);
+
+        Request->SetURL(FString::Printf(TEXT("%s/v1/upload/sessions"), *Settings->GetServiceURL()));
+        Request->SetVerb("POST");
+        Request->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+        Request->SetContentAsString(RequestContent);
+    }
+    else
     {
-        UE_LOG(LogMythica, Error, TEXT("Unable to create job due to session not created"));
-        return -1;
+        // Ask the server how much of the file it received before the failure
+        Request->SetURL(FString::Printf(TEXT("%s/v1/upload/sessions/%s"), *Settings->GetServiceURL(), *Upload->ResumableUploadId));
+        Request->SetVerb("GET");
     }
 
-    FString ExportDirectory;
-    TMap<int, FString> InputFiles;
-    bool bSuccess = PrepareInputFiles(Params, InputFiles, ExportDirectory, Origin);
-    if (!bSuccess)
+    Upload->Request = Request;
+    Request->ProcessRequest();
+}
+
+void UMythicaEditorSubsystem::OnResumableUploadStatus(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, int UploadId)
+{
+    FMythicaFileUpload* Upload = FindActiveFileUpload(UploadId);
+    if (!Upload)
     {
-        UE_LOG(LogMythica, Error, TEXT("Failed to prepare job input files"));
-        return -1;
+        ReleaseUploadSlot();
+        return;
     }
 
-    int RequestId = CreateJob(JobDefId, Params, ImportPath, ExecutingComp);
+    if (DisableUploadCompression(UploadId, Response))
+    {
+        ReleaseUploadSlot();
+        return;
+    }
 
-    if (InputFiles.IsEmpty())
+    TSharedPtr<FJsonObject> JsonObject;
+    if (bWasSuccessful && Response.IsValid() && EHttpResponseCodes::IsOk(Response->GetResponseCode()))
     {
-        SendJobRequest(RequestId);
+        TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Response->GetContentAsString());
+        FJsonSerializer::Deserialize(Reader, JsonObject);
     }
-    else
+
+    FString ResumableUploadId;
+    double Offset = 0.0;
+    if (!JsonObject.IsValid() || !JsonObject->TryGetStringField(TEXT("upload_id"), ResumableUploadId) || !JsonObject->TryGetNumberField(TEXT("offset"), Offset))
     {
-        UploadInputFiles(RequestId, InputFiles);
-        if (MYTHICA_CLEAN_TEMP_FILES)
+        // An expired or unknown session starts over with a new one
+        if (Response.IsValid() && Response->GetResponseCode() == EHttpResponseCodes::NotFound)
         {
-            IFileManager::Get().DeleteDirectory(*ExportDirectory, false, true);
+            Upload->ResumableUploadId.Empty();
+            SetUploadOffset(*Upload, 0);
         }
+
+        ReleaseUploadSlot();
+        FailFileUpload(UploadId, Response.IsValid() ? FString::Printf(TEXT("upload session status %d"), Response->GetResponseCode()) : TEXT("connection failed"));
+        return;
     }
 
-    return RequestId;
-}
+    Upload->ResumableUploadId = ResumableUploadId;
+    SetUploadOffset(*Upload, (int64)Offset);
 
-void UMythicaEditorSubsystem::SendJobRequest(int RequestId)
-{
-    FMythicaJob* RequestData = Jobs.Find(RequestId);
-    if (!RequestData)
+    FString FileId;
+    if (JsonObject->TryGetStringField(TEXT("file_id"), FileId) && !FileId.IsEmpty())
     {
+        ReleaseUploadSlot();
+        FinishFileUpload(UploadId, FileId);
         return;
     }
 
-    // Create JSON payload
-    TSharedPtr<FJsonObject> ParamsSetObject = MakeShareable(new FJsonObject);
-    Mythica::WriteParameters(RequestData->InputFileIds, RequestData->Params, ParamsSetObject);
-
-    TSharedPtr<FJsonObject> JsonObject = MakeShareable(new FJsonObject);
-    JsonObject->SetStringField(TEXT("job_def_id"), RequestData->JobDefId);
-    JsonObject->SetObjectField(TEXT("params"), ParamsSetObject);
+    SendUploadPart(UploadId);
+}
 
-    FString ContentJson;
-    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ContentJson);
-    bool Success = FJsonSerializer::Serialize(JsonObject.ToSharedRef(), Writer);
-    check(Success);
+void UMythicaEditorSubsystem::SendUploadPart(int UploadId)
+{
+    FMythicaFileUpload* Upload = FileUploads.Find(UploadId);
+    if (!Upload)
+    {
+        return;
+    }
 
-    // Send request
     const UMythicaDeveloperSettings* Settings = GetDefault<UMythicaDeveloperSettings>();
+    int64 PartSize = FMath::Min((int64)Settings->UploadPartSizeMB * 1024 * 1024, Upload->Size - Upload->Offset);
 
-    FString Url = FString::Printf(TEXT("%s/v1/jobs/"), *Settings->GetServiceURL());
-
-    auto Callback = [this, RequestId](FHttpRequestPtr Request, FHttpResponsePtr Response, bool bConnectedSuccessfully)
+    auto Callback = [this, UploadId](FHttpRequestPtr Request, FHttpResponsePtr Response, bool bConnectedSuccessfully)
     {
-        OnExecuteJobResponse(Request, Response, bConnectedSuccessfully, RequestId);
+        OnUploadPartResponse(Request, Response, bConnectedSuccessfully, UploadId);
     };
 
+    FString Url = FString::Printf(TEXT("%s/v1/upload/sessions/%s?offset=%lld"), *Settings->GetServiceURL(), *Upload->ResumableUploadId, Upload->Offset);
+    FString ContentRange = FString::Printf(TEXT("bytes %lld-%lld/%lld"), Upload->Offset, Upload->Offset + PartSize - 1, Upload->Size);
+
     TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
     Request->SetURL(Url);
-    Request->SetVerb("POST");
+    Request->SetVerb("PUT");
     Request->SetHeader("Authorization", FString::Printf(TEXT("Bearer %s"), *AuthToken));
-    Request->SetHeader("Content-Type", "application/json");
-    Request->SetContentAsString(ContentJson);
+    Request->SetHeader(TEXT("Content-Type"), TEXT("application/octet-stream"));
+    Request->SetHeader(TEXT("Content-Range"), ContentRange);
+    Request->SetContentFromStream(MakeShared<FMythicaDataRangeStream, ESPMode::ThreadSafe>(Upload->UploadData, Upload->Offset, PartSize));
     Request->OnProcessRequestComplete().BindLambda(Callback);
+#if UE_VERSION_OLDER_THAN(5, 4, 0)
+    Request->OnRequestProgress().BindLambda([this, UploadId](FHttpRequestPtr, int32 BytesSent, int32)
+    {
+        OnFileUploadProgress(UploadId, (uint64)BytesSent);
+    });
+#else
+    Request->OnRequestProgress64().BindLambda([this, UploadId](FHttpRequestPtr, uint64 BytesSent, uint64)
+    {
+        OnFileUploadProgress(UploadId, BytesSent);
+    });
+#endif
 
+    Upload->Request = Request;
     Request->ProcessRequest();
 }
 
-void UMythicaEditorSubsystem::OnExecuteJobResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, int RequestId)
+void UMythicaEditorSubsystem::OnUploadPartResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, int UploadId)
 {
-    FMythicaJob* RequestData = Jobs.Find(RequestId);
-    if (!RequestData)
+    FMythicaFileUpload* Upload = FindActiveFileUpload(UploadId);
+    if (!Upload)
     {
+        ReleaseUploadSlot();
         return;
     }
 
-    if (!bWasSuccessful || !Response.IsValid())
+    // A conflict reports the offset the server expects, continue from there
+    int32 ResponseCode = Response.IsValid() ? Response->GetResponseCode() : 0;
+    TSharedPtr<FJsonObject> JsonObject;
+    if (bWasSuccessful && (EHttpResponseCodes::IsOk(ResponseCode) || ResponseCode == EHttpResponseCodes::Conflict))
     {
-        UE_LOG(LogMythica, Error, TEXT("Failed to request job"));
-        SetJobState(RequestId, EMythicaJobState::Failed, FText::FromString("Failed to request job 1"));
+        TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Response->GetContentAsString());
+        FJsonSerializer::Deserialize(Reader, JsonObject);
+    }
+
+    double Offset = 0.0;
+    if (!JsonObject.IsValid() || !JsonObject->TryGetNumberField(TEXT("offset"), Offset))
+    {
+        ReleaseUploadSlot();
+        FailFileUpload(UploadId, bWasSuccessful && Response.IsValid() ? FString::Printf(TEXT("upload part status %d"), ResponseCode) : TEXT("connection failed"));
         return;
     }
 
-    FString ResponseContent = Response->GetContentAsString();
-    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(ResponseContent);
+    SetUploadOffset(*Upload, (int64)Offset);
+    if (ResponseCode != EHttpResponseCodes::Conflict)
+    {
+        Upload->Attempt = 0;
+    }
 
-    TSharedPtr<FJsonObject> JsonObject;
-    if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
+    FString FileId;
+    if (JsonObject->TryGetStringField(TEXT("file_id"), FileId) && !FileId.IsEmpty())
     {
-        UE_LOG(LogMythica, Error, TEXT("Failed to parse create job JSON string"));
-        SetJobState(RequestId, EMythicaJobState::Failed, FText::FromString("Failed to request job 2"));
+        ReleaseUploadSlot();
+        FinishFileUpload(UploadId, FileId);
         return;
     }
 
-    FString JobId;
-    if (!JsonObject->TryGetStringField(TEXT("job_id"), JobId))
+    if (Upload->Offset >= Upload->Size)
     {
-        UE_LOG(LogMythica, Error, TEXT("Failed to get JobId from JSON string"));
-        SetJobState(RequestId, EMythicaJobState::Failed, FText::FromString("Failed to request job 3"));
+        ReleaseUploadSlot();
+        FailFileUpload(UploadId, TEXT("upload session completed without a file id"));
         return;
     }
 
-    RequestData->JobId = JobId;
-    SetJobState(RequestId, EMythicaJobState::Queued);
+    SendUploadPart(UploadId);
 }
 
-int UMythicaEditorSubsystem::CreateJob(const FString& JobDefId, const FMythicaParameters& Params, const FString& ImportPath, UMythicaComponent* Component)
+FMythicaFileUpload* UMythicaEditorSubsystem::FindActiveFileUpload(int UploadId)
 {
-    int RequestId = NextRequestId++;
+    // Canceled along with its job
+    FMythicaFileUpload* Upload = FileUploads.Find(UploadId);
+    if (!Upload)
+    {
+        return nullptr;
+    }
+
+    Upload->Request.Reset();
+
+    FMythicaJob* RequestData = Jobs.Find(Upload->RequestId);
+    if (!RequestData || JobFinished(RequestData->State))
+    {
+        FileUploads.Remove(UploadId);
+        return nullptr;
+    }
+
+    return Upload;
+}
+
+void UMythicaEditorSubsystem::ReleaseUploadSlot()
+{
+    ActiveUploads = FMath::Max(ActiveUploads - 1, 0);
+
+    // Start the next file on the next tick, after the caller is done with the current one
+    GEditor->GetTimerManager()->SetTimerForNextTick(FTimerDelegate::CreateUObject(this, &UMythicaEditorSubsystem::StartQueuedUploads));
+}
+
+void UMythicaEditorSubsystem::SetUploadOffset(FMythicaFileUpload& Upload, int64 Offset)
+{
+    Upload.Offset = FMath::Clamp<int64>(Offset, 0, Upload.Size);
+
+    // Progress follows what the server confirmed, bytes of an interrupted part are sent again
+    FMythicaJob* RequestData = Jobs.Find(Upload.RequestId);
+    if (RequestData)
+    {
+        RequestData->UploadedBytes = FMath::Clamp<int64>(RequestData->UploadedBytes + Upload.Offset - Upload.SentBytes, 0, RequestData->UploadSize);
+    }
+    Upload.SentBytes = Upload.Offset;
+}
+
+bool UMythicaEditorSubsystem::DisableUploadCompression(int UploadId, FHttpResponsePtr Response)
+{
+    FMythicaFileUpload& Upload = FileUploads[UploadId];
+    if (!Response.IsValid() || Response->GetResponseCode() != EHttpResponseCodes::UnsupportedMedia || Upload.ContentEncoding.IsEmpty())
+    {
+        return false;
+    }
+
+    // The service doesn't accept compressed files, send this and every following file uncompressed
+    UE_LOG(LogMythica, Warning, TEXT("Service rejected compressed upload, disabling upload compression for this session"));
+    UploadCompressionSupported = false;
+
+    FMythicaJob& Job = Jobs[Upload.RequestId];
+    SetUploadOffset(Upload, 0);
+
+    int64 RawSize = Upload.Data->Num();
+    Job.UploadSize += RawSize - Upload.Size;
+
+    Upload.UploadData = Upload.Data;
+    Upload.ContentEncoding.Empty();
+    Upload.ResumableUploadId.Empty();
+    Upload.Size = RawSize;
+
+    QueuedUploadIds.Insert(UploadId, 0);
+    return true;
+}
+
+void UMythicaEditorSubsystem::FailFileUpload(int UploadId, const FString& Error)
+{
+    FMythicaFileUpload& Upload = FileUploads[UploadId];
+    const UMythicaDeveloperSettings* Settings = GetDefault<UMythicaDeveloperSettings>();
+
+    // Discount the bytes the server didn't confirm
+    SetUploadOffset(Upload, Upload.Offset);
+
+    if (Upload.Attempt < Settings->UploadRetryCount)
+    {
+        float Delay = Settings->UploadRetryDelaySeconds * FMath::Pow(2.0f, (float)Upload.Attempt) * FMath::FRandRange(0.8f, 1.2f);
+        Upload.Attempt++;
+
+        UE_LOG(LogMythica, Warning, TEXT("Failed to upload %s at %lld of %lld bytes (%s), retry %d of %d in %.1fs"),
+            *FPaths::GetCleanFilename(Upload.FilePath), Upload.Offset, Upload.Size, *Error, Upload.Attempt, Settings->UploadRetryCount, Delay);
+
+        FTimerDelegate TimerDelegate = FTimerDelegate::CreateUObject(this, &UMythicaEditorSubsystem::RetryFileUpload, UploadId);
+        GEditor->GetTimerManager()->SetTimer(Upload.RetryTimer, TimerDelegate, FMath::Max(Delay, 0.01f), false);
+        return;
+    }
+
+    FString Message = FString::Printf(TEXT("Failed to upload input %d (%s): %s"), Upload.InputIndex, *FPaths::GetCleanFilename(Upload.FilePath), *Error);
+    UE_LOG(LogMythica, Error, TEXT("%s"), *Message);
+    SetJobState(Upload.RequestId, EMythicaJobState::Failed, FText::FromString(Message));
+}
+
+void UMythicaEditorSubsystem::FinishFileUpload(int UploadId, const FString& FileId)
+{
+    FMythicaFileUpload Upload;
+    FileUploads.RemoveAndCopyValue(UploadId, Upload);
+
+    int RequestId = Upload.RequestId;
+    FMythicaJob& RequestData = Jobs[RequestId];
+    RequestData.UploadMetrics.SentBytes += Upload.Size;
+
+    RequestData.InputFileIds.SetNum(FMath::Max(RequestData.InputFileIds.Num(), Upload.InputIndex + 1), false);
+    RequestData.InputFileIds[Upload.InputIndex] = FileId;
+
+    const UMythicaDeveloperSettings* Settings = GetDefault<UMythicaDeveloperSettings>();
+    if (Settings->EnableUploadCache)
+    {
+        FString ServiceURL = Settings->GetServiceURL();
+        for (const FString& Key : RequestData.InputUploadKeys.FindRef(Upload.InputIndex))
+        {
+            UploadCache.AddFileId(Key, ServiceURL, FileId);
+        }
+    }
+
+    RequestData.PendingUploads--;
+    if (RequestData.PendingUploads <= 0)
+    {
+        OnInputFilesUploaded(RequestId);
+    }
+}
+
+void UMythicaEditorSubsystem::OnInputFilesUploaded(int RequestId)
+{
+    FMythicaJob* RequestData = Jobs.Find(RequestId);
+    if (!RequestData)
+    {
+        return;
+    }
+
+    RequestData->UploadedBytes = RequestData->UploadSize;
+
+    // Time saved is the upload time of the bytes compression removed at the measured bandwidth
+    FMythicaUploadMetrics& Metrics = RequestData->UploadMetrics;
+    Metrics.UploadSeconds = FPlatformTime::Seconds() - RequestData->UploadStartTime;
+    if (Metrics.SentBytes < Metrics.RawBytes && Metrics.UploadSeconds > 0.0)
+    {
+        double BytesPerSecond = Metrics.SentBytes / Metrics.UploadSeconds;
+        Metrics.SecondsSaved = (Metrics.RawBytes - Metrics.SentBytes) / BytesPerSecond - Metrics.CompressSeconds;
+
+        UE_LOG(LogMythica, Log, TEXT("Uploaded %d inputs: %.1f MB compressed to %.1f MB (%.2fx) in %.2fs, compression took %.2fs and saved %.2fs"),
+            Metrics.Files, Metrics.RawBytes / (1024.0 * 1024.0), Metrics.SentBytes / (1024.0 * 1024.0), Metrics.GetCompressionRatio(),
+            Metrics.UploadSeconds, Metrics.CompressSeconds, Metrics.SecondsSaved);
+    }
+
+    if (MYTHICA_CLEAN_TEMP_FILES && !RequestData->ExportDirectory.IsEmpty())
+    {
+        IFileManager::Get().DeleteDirectory(*RequestData->ExportDirectory, false, true);
+    }
+    RequestData->ExportDirectory.Empty();
+
+    OnSharedInputsUploaded(RequestId);
+    SendJobRequest(RequestId);
+}
+
+void UMythicaEditorSubsystem::CancelFileUploads(int RequestId)
+{
+    TArray<FHttpRequestPtr> Requests;
+    for (auto It = FileUploads.CreateIterator(); It; ++It)
+    {
+        if (It.Value().RequestId != RequestId)
+        {
+            continue;
+        }
+
+        if (It.Value().Request.IsValid())
+        {
+            Requests.Add(It.Value().Request);
+        }
+        GEditor->GetTimerManager()->ClearTimer(It.Value().RetryTimer);
+
+        QueuedUploadIds.Remove(It.Key());
+        It.RemoveCurrent();
+    }
+
+    // The completion callbacks find the uploads gone and only release their slots
+    for (const FHttpRequestPtr& Request : Requests)
+    {
+        Request->CancelRequest();
+    }
+
+    FMythicaJob* RequestData = Jobs.Find(RequestId);
+    if (RequestData && !RequestData->ExportDirectory.IsEmpty())
+    {
+        if (MYTHICA_CLEAN_TEMP_FILES)
+        {
+            IFileManager::Get().DeleteDirectory(*RequestData->ExportDirectory, false, true);
+        }
+        RequestData->ExportDirectory.Empty();
+    }
+}
+
+int UMythicaEditorSubsystem::ExecuteJob(
+    const FString& JobDefId, 
+    const FMythicaParameters& Params, 
+    const FString& ImportPath,
+    const FVector& Origin,
+    UMythicaComponent* ExecutingComp
+) {
+    FText Error;
+    return ExecuteJob(JobDefId, Params, ImportPath, Origin, ExecutingComp, Error);
+}
+
+int UMythicaEditorSubsystem::ExecuteJob(
+    const FString& JobDefId,
+    const FMythicaParameters& Params,
+    const FString& ImportPath,
+    const FVector& Origin,
+    UMythicaComponent* ExecutingComp,
+    FText& OutError
+) {
+    if (SessionState != EMythicaSessionState::SessionCreated)
+    {
+        UE_LOG(LogMythica, Error, TEXT("Unable to create job due to session not created"));
+        OutError = FText::FromString("Unable to create job, no session with the Mythica service");
+        return -1;
+    }
+
+    if (JobDefId.IsEmpty())
+    {
+        UE_LOG(LogMythica, Error, TEXT("Unable to create job without a job definition"));
+        OutError = FText::FromString("Unable to create job, no tool selected");
+        return -1;
+    }
+
+    FString Fingerprint = LexToString(Mythica::ComputeJobFingerprint(JobDefId, Params, Origin));
+
+    // Wait on the result of an identical job instead of sending it again
+    int LeaderRequestId = FindInFlightJob(Fingerprint);
+    if (LeaderRequestId != -1)
+    {
+        int RequestId = CreateJob(JobDefId, Params, ImportPath, Origin, Fingerprint, ExecutingComp);
+
+        FMythicaJob& Job = Jobs[RequestId];
+        Job.LeaderRequestId = LeaderRequestId;
+        Job.CacheResult = EMythicaJobCacheResult::InFlightHit;
+        Jobs[LeaderRequestId].FollowerRequestIds.Add(RequestId);
+
+        // Catch up with the leader on the next tick so the caller can bind to job state changes first
+        FTimerDelegate TimerDelegate = FTimerDelegate::CreateUObject(this, &UMythicaEditorSubsystem::SyncFollowerState, RequestId, FText::GetEmpty());
+        GEditor->GetTimerManager()->SetTimerForNextTick(TimerDelegate);
+
+        return RequestId;
+    }
+
+    int RequestId = CreateJob(JobDefId, Params, ImportPath, Origin, Fingerprint, ExecutingComp);
+
+    UMythicaJobSubsystem* JobSubsystem = GEngine->GetEngineSubsystem<UMythicaJobSubsystem>();
+    JobSubsystem->EnqueueJob(RequestId, ExecutingComp);
+
+    return RequestId;
+}
+
+TArray<int> UMythicaEditorSubsystem::ExecuteJobBatch(
+    const FString& JobDefId,
+    const TArray<FMythicaParameters>& ParamSets,
+    const TArray<FString>& ImportPaths,
+    const FVector& Origin,
+    UMythicaComponent* ExecutingComp
+) {
+    check(ParamSets.Num() == ImportPaths.Num());
+
+    FGuid BatchId = FGuid::NewGuid();
+
+    TArray<int> RequestIds;
+    for (int i = 0; i < ParamSets.Num(); ++i)
+    {
+        int RequestId = ExecuteJob(JobDefId, ParamSets[i], ImportPaths[i], Origin, ExecutingComp);
+        if (RequestId > 0)
+        {
+            // Jobs start on a later tick, after the whole batch was created
+            Jobs[RequestId].InputBatchId = BatchId;
+        }
+
+        RequestIds.Add(RequestId);
+    }
+
+    return RequestIds;
+}
+
+UMythicaVariantBatch* UMythicaEditorSubsystem::GenerateVariants(UMythicaComponent* Component, const TArray<FMythicaParameterVariant>& Variants)
+{
+    VariantBatches.RemoveAll([](const UMythicaVariantBatch* Batch) { return !Batch || !Batch->IsRunning(); });
+
+    UMythicaVariantBatch* Batch = NewObject<UMythicaVariantBatch>(this);
+    if (Batch->Start(Component, Variants))
+    {
+        VariantBatches.Add(Batch);
+    }
+
+    return Batch;
+}
+
+UMythicaBulkRegenerate* UMythicaEditorSubsystem::RegenerateAllComponents(bool bForce)
+{
+    if (!BulkRegenerate)
+    {
+        BulkRegenerate = NewObject<UMythicaBulkRegenerate>(this);
+    }
+
+    if (!IsRegeneratingAllComponents())
+    {
+        BulkRegenerate->Start(GEditor->GetEditorWorldContext().World(), bForce);
+    }
+
+    return BulkRegenerate;
+}
+
+UMythicaWorldPartitionRegenerate* UMythicaEditorSubsystem::RegenerateWorldPartition(bool bForce)
+{
+    if (!WorldPartitionRegenerate)
+    {
+        WorldPartitionRegenerate = NewObject<UMythicaWorldPartitionRegenerate>(this);
+    }
+
+    if (!IsRegeneratingAllComponents())
+    {
+        WorldPartitionRegenerate->Start(GEditor->GetEditorWorldContext().World(), bForce);
+    }
+
+    return WorldPartitionRegenerate;
+}
+
+void UMythicaEditorSubsystem::CancelRegenerateAllComponents()
+{
+    if (WorldPartitionRegenerate)
+    {
+        WorldPartitionRegenerate->Cancel();
+    }
+
+    if (BulkRegenerate)
+    {
+        BulkRegenerate->Cancel();
+    }
+}
+
+bool UMythicaEditorSubsystem::IsRegeneratingAllComponents() const
+{
+    return (BulkRegenerate && BulkRegenerate->IsRunning()) || (WorldPartitionRegenerate && WorldPartitionRegenerate->IsRunning());
+}
+
+void UMythicaEditorSubsystem::StartJob(int RequestId)
+{
+    FMythicaJob* RequestData = Jobs.Find(RequestId);
+    if (!RequestData || RequestData->State != EMythicaJobState::Scheduled)
+    {
+        GEngine->GetEngineSubsystem<UMythicaJobSubsystem>()->OnJobFinished(RequestId);
+        return;
+    }
+
+    SetJobState(RequestId, EMythicaJobState::Requesting);
+
+    const UMythicaDeveloperSettings* Settings = GetDefault<UMythicaDeveloperSettings>();
+    if (Settings->EnableResultCache && HasCachedResult(RequestData->Fingerprint))
+    {
+        ResolveJobFromCache(RequestId);
+    }
+    else if (Settings->EnableResultCache && Settings->EnableSharedResultCache)
+    {
+        RequestSharedResult(RequestId);
+    }
+    else
+    {
+        PrepareAndSubmitJob(RequestId);
+    }
+}
+
+void UMythicaEditorSubsystem::SubmitJob(int RequestId, TArray<FMythicaInputExport>&& InputExports, const FString& ExportDirectory)
+{
+    if (InputExports.IsEmpty())
+    {
+        OnSharedInputsUploaded(RequestId);
+        SendJobRequest(RequestId);
+        if (MYTHICA_CLEAN_TEMP_FILES)
+        {
+            IFileManager::Get().DeleteDirectory(*ExportDirectory, false, true);
+        }
+        return;
+    }
+
+    FMythicaJob& Job = Jobs[RequestId];
+    Job.PendingUploads = InputExports.Num();
+    Job.ExportDirectory = ExportDirectory;
+    Job.UploadedBytes = 0;
+    Job.UploadSize = 0;
+
+    // Inputs are packaged in memory in parallel, each one is uploaded as soon as it is ready
+    bool HashInputs = GetDefault<UMythicaDeveloperSettings>()->EnableUploadCache;
+
+    TWeakObjectPtr<UMythicaEditorSubsystem> WeakThis(this);
+    for (FMythicaInputExport& Export : InputExports)
+    {
+        Async(EAsyncExecution::ThreadPool, [WeakThis, RequestId, InputIndex = Export.InputIndex, FilePath = Export.FilePath, Writer = MoveTemp(Export.Writer), HashInputs]() mutable
+        {
+            TArray64<uint8> Packaged;
+            FMythicaUploadData Data;
+            FString UploadKey;
+            if (Writer(Packaged))
+            {
+                UploadKey = HashInputs ? FMythicaUploadCache::HashData(Packaged) : FString();
+                Data = MakeShared<TArray64<uint8>, ESPMode::ThreadSafe>(MoveTemp(Packaged));
+            }
+
+            AsyncTask(ENamedThreads::GameThread, [WeakThis, RequestId, InputIndex, FilePath, Data, UploadKey]()
+            {
+                if (UMythicaEditorSubsystem* Subsystem = WeakThis.Get())
+                {
+                    Subsystem->OnInputFileExported(RequestId, InputIndex, FilePath, Data, UploadKey);
+                }
+            });
+        });
+    }
+}
+
+bool UMythicaEditorSubsystem::HasCachedResult(const FString& Fingerprint)
+{
+    FString CachedPath;
+    return ResultCache.FindImportDirectory(Fingerprint, CachedPath) || ResultCache.FindResultFile(Fingerprint, CachedPath);
+}
+
+void UMythicaEditorSubsystem::ResolveJobFromCache(int RequestId)
+{
+    FMythicaJob* RequestData = Jobs.Find(RequestId);
+    if (!RequestData || RequestData->State == EMythicaJobState::Canceled)
+    {
+        return;
+    }
+
+    const UMythicaDeveloperSettings* Settings = GetDefault<UMythicaDeveloperSettings>();
+    FString ImportDirectory = FPaths::Combine(Settings->GeneratedAssetImportDirectory, RequestData->ImportPath);
+
+    SetJobState(RequestId, EMythicaJobState::Importing);
+
+    // Reuse an existing import, either in place or by duplicating the assets of another component
+    FString CachedImportDirectory;
+    if (ResultCache.FindImportDirectory(RequestData->Fingerprint, CachedImportDirectory))
+    {
+        if (CachedImportDirectory == ImportDirectory || Mythica::DuplicateImport(CachedImportDirectory, ImportDirectory))
+        {
+            ResultCache.SetImportDirectory(RequestData->Fingerprint, ImportDirectory);
+
+            RequestData->CacheResult = EMythicaJobCacheResult::ImportHit;
+            RequestData->ImportDirectory = ImportDirectory;
+            SetJobState(RequestId, EMythicaJobState::Completed);
+            return;
+        }
+    }
+
+    // Import the cached result file
+    FString CachedFile;
+    if (ResultCache.FindResultFile(RequestData->Fingerprint, CachedFile))
+    {
+        FString ImportFile = MakeResultImportFilePath(*RequestData);
+        if (IFileManager::Get().Copy(*ImportFile, *CachedFile) == COPY_OK)
+        {
+            RequestData->CacheResult = EMythicaJobCacheResult::FileHit;
+            ImportResultFile(ImportFile, RequestId);
+            return;
+        }
+    }
+
+    // Cache entry disappeared in the meantime, fall back to the shared cache or the server
+    if (Settings->EnableSharedResultCache)
+    {
+        RequestSharedResult(RequestId);
+        return;
+    }
+
+    PrepareAndSubmitJob(RequestId);
+}
+
+void UMythicaEditorSubsystem::RequestSharedResult(int RequestId)
+{
+    FMythicaJob* RequestData = Jobs.Find(RequestId);
+    if (!RequestData)
+    {
+        return;
+    }
+
+    FMythicaSharedResultCache::Get(RequestData->Fingerprint, FMythicaSharedResultCache::FOnGetComplete::CreateUObject(this, &UMythicaEditorSubsystem::OnSharedResultResponse, RequestId));
+}
+
+void UMythicaEditorSubsystem::OnSharedResultResponse(bool bHit, const TArray<uint8>& FileData, int RequestId)
+{
+    FMythicaJob* RequestData = Jobs.Find(RequestId);
+    if (!RequestData || RequestData->State == EMythicaJobState::Canceled)
+    {
+        return;
+    }
+
+    if (!bHit || FileData.IsEmpty())
+    {
+        PrepareAndSubmitJob(RequestId);
+        return;
+    }
+
+    UE_LOG(LogMythica, Verbose, TEXT("Pulled result %s from the derived data cache"), *RequestData->Fingerprint);
+
+    RequestData->CacheResult = EMythicaJobCacheResult::SharedHit;
+
+    ResultCache.AddResult(RequestData->Fingerprint, FileData);
+    ResultCache.Trim((int64)GetDefault<UMythicaDeveloperSettings>()->ResultCacheSizeMB * 1024 * 1024);
+
+    FString CacheImportFile = MakeResultImportFilePath(*RequestData);
+    if (!FFileHelper::SaveArrayToFile(FileData, *CacheImportFile))
+    {
+        UE_LOG(LogMythica, Error, TEXT("Failed to write mesh file %s"), *CacheImportFile);
+        SetJobState(RequestId, EMythicaJobState::Failed, FText::FromString("Failed to import result mesh 1"));
+        return;
+    }
+
+    SetJobState(RequestId, EMythicaJobState::Importing);
+    ImportResultFile(CacheImportFile, RequestId);
+}
+
+void UMythicaEditorSubsystem::PrepareAndSubmitJob(int RequestId)
+{
+    FMythicaJob* RequestData = Jobs.Find(RequestId);
+    if (!RequestData)
+    {
+        return;
+    }
+
+    const UMythicaDeveloperSettings* Settings = GetDefault<UMythicaDeveloperSettings>();
+    RequestData->CacheResult = Settings->EnableResultCache ? EMythicaJobCacheResult::Miss : EMythicaJobCacheResult::None;
+
+    if (WaitForSharedInputs(RequestId))
+    {
+        return;
+    }
+
+    // Unchanged inputs skip the export and upload
+    TMap<int, FString> UploadedInputs;
+    if (Settings->EnableUploadCache)
+    {
+        FindUploadedInputs(RequestId, UploadedInputs);
+    }
+
+    FString ExportDirectory;
+    TArray<FMythicaInputExport> InputExports;
+    FMythicaExportStats ExportStats;
+    bool bSuccess = PrepareInputFiles(RequestData->Params, InputExports, ExportDirectory, RequestData->Origin, UploadedInputs, ExportStats);
+    if (!bSuccess)
+    {
+        UE_LOG(LogMythica, Error, TEXT("Failed to prepare job input files"));
+        SetJobState(RequestId, EMythicaJobState::Failed, FText::FromString("Failed to prepare input files"));
+        return;
+    }
+
+    RequestData->UploadMetrics = FMythicaUploadMetrics();
+    RequestData->UploadMetrics.StrippedBytes = ExportStats.StrippedBytes;
+    if (ExportStats.StrippedBytes > 0)
+    {
+        UE_LOG(LogMythica, Log, TEXT("Geometry only inputs left out %.1f KB of materials and UV sets"), ExportStats.StrippedBytes / 1024.0);
+    }
+
+    for (const TPair<int, FString>& Pair : UploadedInputs)
+    {
+        RequestData->InputFileIds.SetNum(FMath::Max(RequestData->InputFileIds.Num(), Pair.Key + 1), false);
+        RequestData->InputFileIds[Pair.Key] = Pair.Value;
+    }
+
+    if (!UploadedInputs.IsEmpty())
+    {
+        UE_LOG(LogMythica, Verbose, TEXT("Reusing %d uploaded inputs, exporting %d"), UploadedInputs.Num(), InputExports.Num());
+    }
+
+    SetJobState(RequestId, EMythicaJobState::Requesting);
+    SubmitJob(RequestId, MoveTemp(InputExports), ExportDirectory);
+}
+
+void UMythicaEditorSubsystem::FindUploadedInputs(int RequestId, TMap<int, FString>& OutFileIds)
+{
+    FMythicaJob& Job = Jobs[RequestId];
+    Job.InputUploadKeys.Reset();
+
+    const UMythicaDeveloperSettings* Settings = GetDefault<UMythicaDeveloperSettings>();
+    FString ServiceURL = Settings->GetServiceURL();
+    double ExpirySeconds = Settings->UploadCacheExpiryMinutes * 60.0;
+
+    for (int i = 0; i < Job.Params.Parameters.Num(); i++)
+    {
+        const FMythicaParameter& Param = Job.Params.Parameters[i];
+        if (Param.Type != EMythicaParameterType::File)
+        {
+            continue;
+        }
+
+        FString Key = LexToString(Mythica::ComputeInputFingerprint(Param.ValueFile, Job.Origin));
+        Job.InputUploadKeys.FindOrAdd(i).Add(Key);
+
+        FString FileId;
+        if (UploadCache.FindFileId(Key, ServiceURL, ExpirySeconds, FileId))
+        {
+            OutFileIds.Add(i, FileId);
+        }
+    }
+}
+
+bool UMythicaEditorSubsystem::WaitForSharedInputs(int RequestId)
+{
+    FMythicaJob& Job = Jobs[RequestId];
+    if (!Job.InputBatchId.IsValid())
+    {
+        return false;
+    }
+
+    FMythicaSharedInputs& Shared = SharedInputs.FindOrAdd(Job.InputBatchId);
+    if (Shared.Uploaded)
+    {
+        Job.InputFileIds = Shared.InputFileIds;
+        SetJobState(RequestId, EMythicaJobState::Requesting);
+        SendJobRequest(RequestId);
+        return true;
+    }
+
+    if (Shared.UploaderRequestId != -1 && Shared.UploaderRequestId != RequestId)
+    {
+        Shared.WaitingRequestIds.AddUnique(RequestId);
+        SetJobState(RequestId, EMythicaJobState::Requesting);
+        return true;
+    }
+
+    // First job of the batch to get here exports and uploads the inputs
+    Shared.UploaderRequestId = RequestId;
+    return false;
+}
+
+void UMythicaEditorSubsystem::OnSharedInputsUploaded(int RequestId)
+{
+    FMythicaJob* RequestData = Jobs.Find(RequestId);
+    if (!RequestData || !RequestData->InputBatchId.IsValid())
+    {
+        return;
+    }
+
+    FMythicaSharedInputs* Shared = SharedInputs.Find(RequestData->InputBatchId);
+    if (!Shared || Shared->UploaderRequestId != RequestId)
+    {
+        return;
+    }
+
+    Shared->Uploaded = true;
+    Shared->InputFileIds = RequestData->InputFileIds;
+
+    TArray<FString> InputFileIds = Shared->InputFileIds;
+    TArray<int> WaitingRequestIds = MoveTemp(Shared->WaitingRequestIds);
+    for (int WaitingRequestId : WaitingRequestIds)
+    {
+        FMythicaJob* WaitingJob = Jobs.Find(WaitingRequestId);
+        if (WaitingJob && !JobFinished(WaitingJob->State))
+        {
+            WaitingJob->InputFileIds = InputFileIds;
+            SendJobRequest(WaitingRequestId);
+        }
+    }
+}
+
+void UMythicaEditorSubsystem::ReleaseSharedInputs(int RequestId)
+{
+    FMythicaJob* RequestData = Jobs.Find(RequestId);
+    if (!RequestData || !RequestData->InputBatchId.IsValid())
+    {
+        return;
+    }
+
+    FGuid BatchId = RequestData->InputBatchId;
+    FMythicaSharedInputs* Shared = SharedInputs.Find(BatchId);
+    if (!Shared)
+    {
+        return;
+    }
+
+    // The uploader stopped before the inputs were uploaded, hand the upload over to the next waiting job
+    if (Shared->UploaderRequestId == RequestId && !Shared->Uploaded)
+    {
+        Shared->UploaderRequestId = -1;
+        while (!Shared->WaitingRequestIds.IsEmpty())
+        {
+            int NextRequestId = Shared->WaitingRequestIds[0];
+            Shared->WaitingRequestIds.RemoveAt(0);
+
+            FMythicaJob* NextJob = Jobs.Find(NextRequestId);
+            if (NextJob && !JobFinished(NextJob->State))
+            {
+                PrepareAndSubmitJob(NextRequestId);
+                break;
+            }
+        }
+        return;
+    }
+
+    // Forget the batch once none of its jobs are running
+    for (const TPair<int, FMythicaJob>& Pair : Jobs)
+    {
+        if (Pair.Value.InputBatchId == BatchId && !JobFinished(Pair.Value.State))
+        {
+            return;
+        }
+    }
+
+    SharedInputs.Remove(BatchId);
+}
+
+int UMythicaEditorSubsystem::FindInFlightJob(const FString& Fingerprint) const
+{
+    for (const TPair<int, FMythicaJob>& Pair : Jobs)
+    {
+        const FMythicaJob& Job = Pair.Value;
+        if (Job.LeaderRequestId == -1
+            && Job.Fingerprint == Fingerprint
+            && !JobFinished(Job.State))
+        {
+            return Pair.Key;
+        }
+    }
+
+    return -1;
+}
+
+void UMythicaEditorSubsystem::SyncFollowerState(int RequestId, FText Message)
+{
+    FMythicaJob* Follower = Jobs.Find(RequestId);
+    if (!Follower || JobFinished(Follower->State))
+    {
+        return;
+    }
+
+    const FMythicaJob* Leader = Jobs.Find(Follower->LeaderRequestId);
+    if (!Leader)
+    {
+        return;
+    }
+
+    EMythicaJobState State = Leader->State;
+
+    // Share the import of the leader, duplicating it when the follower imports into a different directory
+    if (State == EMythicaJobState::Completed)
+    {
+        const UMythicaDeveloperSettings* Settings = GetDefault<UMythicaDeveloperSettings>();
+        FString ImportDirectory = FPaths::Combine(Settings->GeneratedAssetImportDirectory, Follower->ImportPath);
+
+        if (Leader->ImportDirectory == ImportDirectory || Mythica::DuplicateImport(Leader->ImportDirectory, ImportDirectory))
+        {
+            Follower->ImportDirectory = ImportDirectory;
+            Follower->EndTime = FDateTime::Now();
+        }
+        else
+        {
+            UE_LOG(LogMythica, Error, TEXT("Failed to duplicate result of job %d"), Follower->LeaderRequestId);
+            State = EMythicaJobState::Failed;
+            Message = FText::FromString("Failed to duplicate result mesh");
+        }
+    }
+
+    if (Follower->State == State)
+    {
+        return;
+    }
+
+    Follower->State = State;
+    OnJobStateChange.Broadcast(RequestId, State, Message);
+}
+
+void UMythicaEditorSubsystem::CancelJob(int RequestId)
+{
+    FMythicaJob* JobData = Jobs.Find(RequestId);
+    if (!JobData || JobData->Canceled || JobFinished(JobData->State))
+    {
+        return;
+    }
+
+    FText Message = FText::FromString("Canceled");
+
+    // Followers only detach from the job they are waiting on
+    if (JobData->LeaderRequestId != -1)
+    {
+        int LeaderRequestId = JobData->LeaderRequestId;
+        SetJobState(RequestId, EMythicaJobState::Canceled, Message);
+
+        FMythicaJob* Leader = Jobs.Find(LeaderRequestId);
+        if (Leader)
+        {
+            Leader->FollowerRequestIds.Remove(RequestId);
+            if (Leader->Canceled)
+            {
+                if (Leader->FollowerRequestIds.IsEmpty())
+                {
+                    StopJob(LeaderRequestId);
+                }
+                else
+                {
+                    Leader->ImportPath = Jobs[Leader->FollowerRequestIds[0]].ImportPath;
+                }
+            }
+        }
+        return;
+    }
+
+    // Keep the job running for the requests waiting on it, the result is imported for the first of them instead
+    if (!JobData->FollowerRequestIds.IsEmpty())
+    {
+        JobData->Canceled = true;
+        JobData->ImportPath = Jobs[JobData->FollowerRequestIds[0]].ImportPath;
+
+        OnJobStateChange.Broadcast(RequestId, EMythicaJobState::Canceled, Message);
+        return;
+    }
+
+    SetJobState(RequestId, EMythicaJobState::Canceled, Message);
+    StopJob(RequestId);
+}
+
+void UMythicaEditorSubsystem::StopJob(int RequestId)
+{
+    FMythicaJob* JobData = Jobs.Find(RequestId);
+    if (!JobData)
+    {
+        return;
+    }
+
+    GEditor->GetTimerManager()->ClearTimer(JobData->TimeoutTimer);
+    JobData->State = EMythicaJobState::Canceled;
+    JobData->Canceled = true;
+
+    GEngine->GetEngineSubsystem<UMythicaJobSubsystem>()->OnJobFinished(RequestId);
+
+    // Drop pending uploads and downloads
+    if (JobData->PendingRequest.IsValid())
+    {
+        FHttpRequestPtr PendingRequest = JobData->PendingRequest;
+        JobData->PendingRequest.Reset();
+        PendingRequest->CancelRequest();
+    }
+
+    CancelFileUploads(RequestId);
+
+    // Without a job id the server hasn't accepted the job yet, it is canceled once the id arrives
+    if (!JobData->JobId.IsEmpty())
+    {
+        SendCancelJobRequest(JobData->JobId);
+    }
+
+    ReleaseSharedInputs(RequestId);
+}
+
+void UMythicaEditorSubsystem::SendCancelJobRequest(const FString& JobId)
+{
+    const UMythicaDeveloperSettings* Settings = GetDefault<UMythicaDeveloperSettings>();
+
+    FString Url = FString::Printf(TEXT("%s/v1/jobs/%s/cancel"), *Settings->GetServiceURL(), *JobId);
+
+    auto Callback = [this, JobId](FHttpRequestPtr Request, FHttpResponsePtr Response, bool bConnectedSuccessfully)
+    {
+        OnCancelJobResponse(Request, Response, bConnectedSuccessfully, JobId);
+    };
+
+    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
+    Request->SetURL(Url);
+    Request->SetVerb("POST");
+    Request->SetHeader("Authorization", FString::Printf(TEXT("Bearer %s"), *AuthToken));
+    Request->SetHeader("Content-Type", "application/json");
+    Request->OnProcessRequestComplete().BindLambda(Callback);
+
+    Request->ProcessRequest();
+}
+
+void UMythicaEditorSubsystem::OnCancelJobResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, FString JobId)
+{
+    if (!bWasSuccessful || !Response.IsValid() || !EHttpResponseCodes::IsOk(Response->GetResponseCode()))
+    {
+        UE_LOG(LogMythica, Warning, TEXT("Failed to cancel job %s, the server will finish it"), *JobId);
+        return;
+    }
+
+    UE_LOG(LogMythica, Verbose, TEXT("Canceled job %s"), *JobId);
+}
+
+void UMythicaEditorSubsystem::SendJobRequest(int RequestId)
+{
+    FMythicaJob* RequestData = Jobs.Find(RequestId);
+    if (!RequestData)
+    {
+        return;
+    }
+
+    // Create JSON payload
+    TSharedPtr<FJsonObject> ParamsSetObject = MakeShareable(new FJsonObject);
+    Mythica::WriteParameters(RequestData->InputFileIds, RequestData->Params, ParamsSetObject);
+
+    TSharedPtr<FJsonObject> JsonObject = MakeShareable(new FJsonObject);
+    JsonObject->SetStringField(TEXT("job_def_id"), RequestData->JobDefId);
+    JsonObject->SetObjectField(TEXT("params"), ParamsSetObject);
+
+    FString ContentJson;
+    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ContentJson);
+    bool Success = FJsonSerializer::Serialize(JsonObject.ToSharedRef(), Writer);
+    check(Success);
+
+    // Send request
+    const UMythicaDeveloperSettings* Settings = GetDefault<UMythicaDeveloperSettings>();
+
+    FString Url = FString::Printf(TEXT("%s/v1/jobs/"), *Settings->GetServiceURL());
+
+    auto Callback = [this, RequestId](FHttpRequestPtr Request, FHttpResponsePtr Response, bool bConnectedSuccessfully)
+    {
+        OnExecuteJobResponse(Request, Response, bConnectedSuccessfully, RequestId);
+    };
+
+    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
+    Request->SetURL(Url);
+    Request->SetVerb("POST");
+    Request->SetHeader("Authorization", FString::Printf(TEXT("Bearer %s"), *AuthToken));
+    Request->SetHeader("Content-Type", "application/json");
+    Request->SetContentAsString(ContentJson);
+    Request->OnProcessRequestComplete().BindLambda(Callback);
+
+    Request->ProcessRequest();
+
+    RequestData->PendingRequest = Request;
+}
+
+void UMythicaEditorSubsystem::OnExecuteJobResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, int RequestId)
+{
+    FMythicaJob* RequestData = Jobs.Find(RequestId);
+    if (!RequestData)
+    {
+        return;
+    }
+
+    RequestData->PendingRequest.Reset();
+
+    if (!bWasSuccessful || !Response.IsValid())
+    {
+        UE_LOG(LogMythica, Error, TEXT("Failed to request job"));
+        SetJobState(RequestId, EMythicaJobState::Failed, FText::FromString("Failed to request job 1"));
+        return;
+    }
+
+    FString ResponseContent = Response->GetContentAsString();
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(ResponseContent);
+
+    TSharedPtr<FJsonObject> JsonObject;
+    if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
+    {
+        UE_LOG(LogMythica, Error, TEXT("Failed to parse create job JSON string"));
+        SetJobState(RequestId, EMythicaJobState::Failed, FText::FromString("Failed to request job 2"));
+        return;
+    }
+
+    FString JobId;
+    if (!JsonObject->TryGetStringField(TEXT("job_id"), JobId))
+    {
+        UE_LOG(LogMythica, Error, TEXT("Failed to get JobId from JSON string"));
+
+        // The server may have dropped inputs that are still in the upload cache
+        UploadCache.RemoveFileIds(RequestData->InputFileIds);
+
+        SetJobState(RequestId, EMythicaJobState::Failed, FText::FromString("Failed to request job 3"));
+        return;
+    }
+
+    RequestData->JobId = JobId;
+
+    // Job was canceled before the server assigned it an id
+    if (RequestData->State == EMythicaJobState::Canceled)
+    {
+        SendCancelJobRequest(JobId);
+        return;
+    }
+
+    SetJobState(RequestId, EMythicaJobState::Queued);
+}
+
+int UMythicaEditorSubsystem::CreateJob(const FString& JobDefId, const FMythicaParameters& Params, const FString& ImportPath, const FVector& Origin, const FString& Fingerprint, UMythicaComponent* Component)
+{
+    int RequestId = NextRequestId++;
 
     FMythicaJob& Job = Jobs.Add(RequestId, { JobDefId, {}, Params, ImportPath });
 
     Job.StartTime = FDateTime::Now();
+    Job.Origin = Origin;
+    Job.Fingerprint = Fingerprint;
 
     if (IsValid(Component))
     {
@@ -1432,7 +2731,7 @@ int UMythicaEditorSubsystem::CreateJob(const FString& JobDefId, const FMythicaPa
 void UMythicaEditorSubsystem::SetJobState(int RequestId, EMythicaJobState State, FText Message)
 {
     FMythicaJob* JobData = Jobs.Find(RequestId);
-    if (!JobData || JobData->State == State)
+    if (!JobData || JobData->State == State || JobData->State == EMythicaJobState::Canceled)
     {
         return;
     }
@@ -1445,7 +2744,7 @@ void UMythicaEditorSubsystem::SetJobState(int RequestId, EMythicaJobState State,
         FTimerDelegate TimerDelegate = FTimerDelegate::CreateUObject(this, &UMythicaEditorSubsystem::OnJobTimeout, RequestId);
         GEditor->GetTimerManager()->SetTimer(JobData->TimeoutTimer, TimerDelegate, Settings->JobTimeoutSeconds, false);
     }
-    else if (State == EMythicaJobState::Importing || State == EMythicaJobState::Failed)
+    else if (State == EMythicaJobState::Importing || State == EMythicaJobState::Failed || State == EMythicaJobState::Canceled)
     {
         GEditor->GetTimerManager()->ClearTimer(JobData->TimeoutTimer);
     }
@@ -1461,7 +2760,30 @@ void UMythicaEditorSubsystem::SetJobState(int RequestId, EMythicaJobState State,
         GEditor->GetTimerManager()->ClearTimer(JobPollTimer);
     }
 
-    OnJobStateChange.Broadcast(RequestId, State, Message);
+    TArray<int> FollowerRequestIds = JobData->FollowerRequestIds;
+
+    // Release the job slot
+    if (JobFinished(State))
+    {
+        GEngine->GetEngineSubsystem<UMythicaJobSubsystem>()->OnJobFinished(RequestId);
+    }
+
+    // The requester already received the canceled state
+    if (!JobData->Canceled)
+    {
+        OnJobStateChange.Broadcast(RequestId, State, Message);
+    }
+
+    for (int FollowerRequestId : FollowerRequestIds)
+    {
+        SyncFollowerState(FollowerRequestId, Message);
+    }
+
+    if (JobFinished(State))
+    {
+        CancelFileUploads(RequestId);
+        ReleaseSharedInputs(RequestId);
+    }
 }
 
 void UMythicaEditorSubsystem::ClearJobs()
@@ -1469,6 +2791,26 @@ void UMythicaEditorSubsystem::ClearJobs()
     Jobs.Reset();
 
     ComponentToJobs.Reset();
+    SharedInputs.Reset();
+
+    TArray<FHttpRequestPtr> UploadRequests;
+    for (TPair<int, FMythicaFileUpload>& Pair : FileUploads)
+    {
+        GEditor->GetTimerManager()->ClearTimer(Pair.Value.RetryTimer);
+        if (Pair.Value.Request.IsValid())
+        {
+            UploadRequests.Add(Pair.Value.Request);
+        }
+    }
+    FileUploads.Reset();
+    QueuedUploadIds.Reset();
+
+    for (const FHttpRequestPtr& Request : UploadRequests)
+    {
+        Request->CancelRequest();
+    }
+
+    GEngine->GetEngineSubsystem<UMythicaJobSubsystem>()->Reset();
 
     GEditor->GetTimerManager()->ClearTimer(JobPollTimer);
 }
@@ -1485,7 +2827,8 @@ void UMythicaEditorSubsystem::PollJobStatus()
         int RequestId = JobEntry.Key;
         const FMythicaJob& JobData = JobEntry.Value;
 
-        if (!JobWaitingForStreamItems(JobData.State))
+        // Followers receive their state from the job they are attached to
+        if (!JobWaitingForStreamItems(JobData.State) || JobData.LeaderRequestId != -1)
         {
             continue;
         }
@@ -1716,6 +3059,7 @@ void UMythicaEditorSubsystem::OnStreamItem(TSharedPtr<FJsonObject> StreamItem)
 
         DownloadInfoRequest->ProcessRequest();
 
+        RequestData->PendingRequest = DownloadInfoRequest;
         SetJobState(RequestId, EMythicaJobState::Importing);
     }
     else if (ItemType == "completed")
@@ -1727,6 +3071,14 @@ void UMythicaEditorSubsystem::OnStreamItem(TSharedPtr<FJsonObject> StreamItem)
 
 void UMythicaEditorSubsystem::OnMeshDownloadInfoResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, int RequestId)
 {
+    FMythicaJob* RequestData = Jobs.Find(RequestId);
+    if (!RequestData || RequestData->State == EMythicaJobState::Canceled)
+    {
+        return;
+    }
+
+    RequestData->PendingRequest.Reset();
+
     if (!bWasSuccessful || !Response.IsValid())
     {
         UE_LOG(LogMythica, Error, TEXT("Failed to get mesh download info"));
@@ -1765,11 +3117,21 @@ void UMythicaEditorSubsystem::OnMeshDownloadInfoResponse(FHttpRequestPtr Request
     DownloadRequest->SetHeader("Content-Type", *ContentType);
     DownloadRequest->OnProcessRequestComplete().BindLambda(Callback);
 
+    // Tracked so a superseded or canceled job stops downloading its result
+    RequestData->PendingRequest = DownloadRequest;
     DownloadRequest->ProcessRequest();
 }
 
 void UMythicaEditorSubsystem::OnMeshDownloadResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, int RequestId)
 {
+    FMythicaJob* RequestData = Jobs.Find(RequestId);
+    if (!RequestData || RequestData->State == EMythicaJobState::Canceled)
+    {
+        return;
+    }
+
+    RequestData->PendingRequest.Reset();
+
     if (!bWasSuccessful || !Response.IsValid())
     {
         UE_LOG(LogMythica, Error, TEXT("Failed to download asset"));
@@ -1790,19 +3152,19 @@ void UMythicaEditorSubsystem::OnResultMeshData(const TArray<uint8>& FileData, in
     }
 
     const UMythicaDeveloperSettings* Settings = GetDefault<UMythicaDeveloperSettings>();
+    if (Settings->EnableResultCache && !RequestData->Fingerprint.IsEmpty())
+    {
+        ResultCache.AddResult(RequestData->Fingerprint, FileData);
+        ResultCache.Trim((int64)Settings->ResultCacheSizeMB * 1024 * 1024);
 
-    // Import over any existing mesh for this component
-    FString ImportDirectory = FPaths::Combine(Settings->GeneratedAssetImportDirectory, RequestData->ImportPath);
-    FString ImportDirectoryParent = FPaths::GetPath(ImportDirectory);
-    FString ImportName = FPaths::GetBaseFilename(RequestData->ImportPath);
-
-    // Store unique file in cache for each import to avoid file locking issues
-    // Name of file must match the desired import folder name
-    FString CacheImportDirectory = FPaths::Combine(FPaths::ProjectIntermediateDir(), TEXT("MythicaCache"), TEXT("GenerateMeshCache"), RequestData->ImportPath);
-    FString UniqueCacheImportDirectory = MakeUniquePath(CacheImportDirectory);
-    FString CacheImportFile = FPaths::Combine(UniqueCacheImportDirectory, ImportName + ".usdz");
+        if (Settings->EnableSharedResultCache)
+        {
+            FMythicaSharedResultCache::Put(RequestData->Fingerprint, FileData);
+        }
+    }
 
     // Save package to disk
+    FString CacheImportFile = MakeResultImportFilePath(*RequestData);
     bool PackageWritten = FFileHelper::SaveArrayToFile(FileData, *CacheImportFile);
     if (!PackageWritten)
     {
@@ -1811,6 +3173,34 @@ void UMythicaEditorSubsystem::OnResultMeshData(const TArray<uint8>& FileData, in
         return;
     }
 
+    ImportResultFile(CacheImportFile, RequestId);
+}
+
+FString UMythicaEditorSubsystem::MakeResultImportFilePath(const FMythicaJob& Job) const
+{
+    // Store unique file in cache for each import to avoid file locking issues
+    // Name of file must match the desired import folder name
+    FString ImportName = FPaths::GetBaseFilename(Job.ImportPath);
+    FString CacheImportDirectory = FPaths::Combine(FPaths::ProjectIntermediateDir(), TEXT("MythicaCache"), TEXT("GenerateMeshCache"), Job.ImportPath);
+    FString UniqueCacheImportDirectory = MakeUniquePath(CacheImportDirectory);
+
+    return FPaths::Combine(UniqueCacheImportDirectory, ImportName + ".usdz");
+}
+
+void UMythicaEditorSubsystem::ImportResultFile(const FString& CacheImportFile, int RequestId)
+{
+    FMythicaJob* RequestData = Jobs.Find(RequestId);
+    if (!RequestData)
+    {
+        return;
+    }
+
+    const UMythicaDeveloperSettings* Settings = GetDefault<UMythicaDeveloperSettings>();
+
+    // Import over any existing mesh for this component
+    FString ImportDirectory = FPaths::Combine(Settings->GeneratedAssetImportDirectory, RequestData->ImportPath);
+    FString ImportDirectoryParent = FPaths::GetPath(ImportDirectory);
+
     // Import the mesh
     bool Success = Mythica::ImportMesh(CacheImportFile, ImportDirectoryParent);
     if (!Success)
@@ -1820,6 +3210,11 @@ void UMythicaEditorSubsystem::OnResultMeshData(const TArray<uint8>& FileData, in
         return;
     }
 
+    if (Settings->EnableResultCache && !RequestData->Fingerprint.IsEmpty())
+    {
+        ResultCache.SetImportDirectory(RequestData->Fingerprint, ImportDirectory);
+    }
+
     RequestData->ImportDirectory = ImportDirectory;
     SetJobState(RequestId, EMythicaJobState::Completed);
 
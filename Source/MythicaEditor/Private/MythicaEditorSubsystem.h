@@ -5,6 +5,9 @@
 #include "Interfaces/IHttpRequest.h"
 #include "Interfaces/IHttpResponse.h"
 #include "IWebSocket.h"
+#include "Jobs/MythicaResultCache.h"
+#include "Jobs/MythicaUploadCache.h"
+#include "Jobs/MythicaUploadStream.h"
 #include "MythicaTypes.h"
 #include "UObject/WeakObjectPtrTemplates.h"
 
@@ -27,12 +30,25 @@ UENUM(BlueprintType)
 enum class EMythicaJobState : uint8
 {
     Invalid,
+    Scheduled,         // Request is waiting for a free job slot
     Requesting,        // Request has been sent to the server
     Queued,            // Request acknowledged by the server and queued for processing
     Processing,        // Request is being processed by the server
     Importing,         // Request has finished processing and the result is being downloaded
     Completed,         // Request has been completed
-    Failed             // Request has failed
+    Failed,            // Request has failed
+    Canceled           // Request was canceled or superseded by a newer request
+};
+
+UENUM(BlueprintType)
+enum class EMythicaJobCacheResult : uint8
+{
+    None,              // Cache was not consulted
+    Miss,              // No cached result, the job was sent to the server
+    FileHit,           // Result file was found in the local cache and imported
+    ImportHit,         // An existing import of the result was reused
+    SharedHit,         // Result file was pulled from the derived data cache and imported
+    InFlightHit        // Attached to an in-flight job with identical inputs
 };
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnSessionStateChanged, EMythicaSessionState, State);
@@ -44,6 +60,7 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnAssetUninstalled, const FString&,
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnJobCreated, int, RequestId, const FString&, ComponentId);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnJobStateChanged, int, RequestId, EMythicaJobState, State, FText, Message);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnGenMeshAssetCreated, int, RequestId);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnJobUploadProgress, int, RequestId, int64, UploadedBytes, int64, UploadSize);
 
 USTRUCT(BlueprintType)
 struct FMythicaStats
@@ -191,6 +208,43 @@ struct FMythicaStreamFile
     uint32 ChunksReceived = 0;
 };
 
+USTRUCT(BlueprintType)
+struct FMythicaUploadMetrics
+{
+    GENERATED_BODY()
+
+public:
+
+    UPROPERTY(BlueprintReadOnly, Category = "Data")
+    int32 Files = 0;
+
+    /** Size of the exported input files */
+    UPROPERTY(BlueprintReadOnly, Category = "Data")
+    int64 RawBytes = 0;
+
+    /** Size of the input files as sent, smaller than RawBytes when they were compressed */
+    UPROPERTY(BlueprintReadOnly, Category = "Data")
+    int64 SentBytes = 0;
+
+    /** Worker thread time spent compressing the inputs */
+    UPROPERTY(BlueprintReadOnly, Category = "Data")
+    double CompressSeconds = 0.0;
+
+    /** Time from starting the upload until every file was uploaded */
+    UPROPERTY(BlueprintReadOnly, Category = "Data")
+    double UploadSeconds = 0.0;
+
+    /** Estimated upload time saved by compression at the measured bandwidth, minus the compression time */
+    UPROPERTY(BlueprintReadOnly, Category = "Data")
+    double SecondsSaved = 0.0;
+
+    /** Estimated size of the materials and UV sets left out of geometry only inputs */
+    UPROPERTY(BlueprintReadOnly, Category = "Data")
+    int64 StrippedBytes = 0;
+
+    float GetCompressionRatio() const { return SentBytes > 0 ? (float)RawBytes / SentBytes : 1.0f; }
+};
+
 USTRUCT(BlueprintType)
 struct FMythicaJob
 {
@@ -211,7 +265,7 @@ public:
     FString ImportPath = FString();
 
     UPROPERTY(BlueprintReadOnly, Category = "Data")
-    EMythicaJobState State = EMythicaJobState::Requesting;
+    EMythicaJobState State = EMythicaJobState::Scheduled;
 
     UPROPERTY(BlueprintReadOnly, Category = "Data")
     FTimerHandle TimeoutTimer;
@@ -236,6 +290,57 @@ public:
     UPROPERTY()
     FMythicaStreamFile StreamFile;
 
+    /** Location the inputs are exported relative to */
+    UPROPERTY(BlueprintReadOnly, Category = "Data")
+    FVector Origin = FVector::ZeroVector;
+
+    /** Hash of the job inputs, identical fingerprints produce identical results */
+    UPROPERTY(BlueprintReadOnly, Category = "Data")
+    FString Fingerprint = FString();
+
+    UPROPERTY(BlueprintReadOnly, Category = "Data")
+    EMythicaJobCacheResult CacheResult = EMythicaJobCacheResult::None;
+
+    /** In-flight job with the same fingerprint this job is waiting on, -1 if the job runs on its own */
+    UPROPERTY(BlueprintReadOnly, Category = "Data")
+    int LeaderRequestId = -1;
+
+    /** Jobs waiting on the result of this job */
+    UPROPERTY(BlueprintReadOnly, Category = "Data")
+    TArray<int> FollowerRequestIds = TArray<int>();
+
+    /** Canceled by the requester, the job only keeps running for its followers */
+    UPROPERTY(BlueprintReadOnly, Category = "Data")
+    bool Canceled = false;
+
+    /** Bytes of the input files sent to the server so far */
+    UPROPERTY(BlueprintReadOnly, Category = "Data")
+    int64 UploadedBytes = 0;
+
+    /** Size of the upload request body, 0 if the job has nothing to upload */
+    UPROPERTY(BlueprintReadOnly, Category = "Data")
+    int64 UploadSize = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Data")
+    FMythicaUploadMetrics UploadMetrics;
+
+    /** Jobs of a batch share a single export and upload of their inputs */
+    UPROPERTY(BlueprintReadOnly, Category = "Data")
+    FGuid InputBatchId = FGuid();
+
+    /** HTTP request currently in flight for the job, dropped when the job is canceled */
+    FHttpRequestPtr PendingRequest;
+
+    /** Upload cache keys of each input, the uploaded file ids are stored under them */
+    TMap<int, TArray<FString>> InputUploadKeys;
+
+    /** Input files that are still being written or uploaded */
+    int PendingUploads = 0;
+    double UploadStartTime = 0.0;
+
+    /** Directory of the exported input files, deleted once they are uploaded */
+    FString ExportDirectory;
+
 };
 
 USTRUCT(BlueprintType)
@@ -251,6 +356,49 @@ public:
 
 };
 
+/** Upload of a single input file of a job */
+struct FMythicaFileUpload
+{
+    int RequestId = -1;
+    int InputIndex = -1;
+    FString FilePath;
+
+    /** Exported input, and the data that is sent which is its compressed copy when the upload is compressed */
+    FMythicaUploadData Data;
+    FMythicaUploadData UploadData;
+    FString ContentEncoding;
+    int64 Size = 0;
+
+    /** Consecutive failed attempts, reset whenever a part of a resumable upload succeeds */
+    int32 Attempt = 0;
+    int64 SentBytes = 0;
+
+    /** Upload session of a resumable upload and the number of bytes the server has confirmed */
+    FString ResumableUploadId;
+    int64 Offset = 0;
+    FHttpRequestPtr Request;
+    FTimerHandle RetryTimer;
+};
+
+/** Input authored on the game thread that still has to be packaged, FilePath names the uploaded file */
+struct FMythicaInputExport
+{
+    int InputIndex = -1;
+    FString FilePath;
+    FMythicaExportWriter Writer;
+};
+
+/** Inputs shared by the jobs of a batch, exported and uploaded by the first job that needs them */
+struct FMythicaSharedInputs
+{
+    int UploaderRequestId = -1;
+    bool Uploaded = false;
+    TArray<FString> InputFileIds;
+
+    /** Jobs waiting for the uploader to finish */
+    TArray<int> WaitingRequestIds;
+};
+
 UCLASS()
 class UMythicaEditorSubsystem : public UEditorSubsystem
 {
@@ -313,6 +461,9 @@ public:
     UFUNCTION(BlueprintPure, Category = "Mythica")
     FString GetImportDirectory(int RequestId);
 
+    /** Data of the job, null if the request is unknown */
+    const FMythicaJob* FindJob(int RequestId) const;
+
     // Requests
     UFUNCTION(BlueprintCallable, Category = "Mythica")
     void CreateSession();
@@ -343,6 +494,51 @@ public:
         const FVector& Origin,
         UMythicaComponent* ExecutingComp);
 
+    /** Returns -1 with the reason in OutError when the job can't be created */
+    int ExecuteJob(
+        const FString& JobDefId,
+        const FMythicaParameters& Params,
+        const FString& ImportPath,
+        const FVector& Origin,
+        UMythicaComponent* ExecutingComp,
+        FText& OutError);
+
+    /**
+     * Submits one job per parameter set. The inputs are exported and uploaded once and shared by all jobs,
+     * so the parameter sets may only differ in their non-input parameters. Returns the request ids in the
+     * order of the parameter sets, -1 for jobs that couldn't be created.
+     */
+    TArray<int> ExecuteJobBatch(
+        const FString& JobDefId,
+        const TArray<FMythicaParameters>& ParamSets,
+        const TArray<FString>& ImportPaths,
+        const FVector& Origin,
+        UMythicaComponent* ExecutingComp);
+
+    /** Generate variants of a component's tool, each imported into a folder next to the component's own results */
+    UFUNCTION(BlueprintCallable, Category = "Mythica")
+    class UMythicaVariantBatch* GenerateVariants(UMythicaComponent* Component, const TArray<FMythicaParameterVariant>& Variants);
+
+    UFUNCTION(BlueprintCallable, Category = "Mythica")
+    void CancelJob(int RequestId);
+
+    /** Called by the job scheduler once the job was given a slot */
+    void StartJob(int RequestId);
+
+    /** Regenerate every Mythica component in the editor world, ordered by their input dependencies */
+    UFUNCTION(BlueprintCallable, Category = "Mythica")
+    class UMythicaBulkRegenerate* RegenerateAllComponents(bool bForce = false);
+
+    /** Regenerate every Mythica component of a world partition map one region at a time */
+    UFUNCTION(BlueprintCallable, Category = "Mythica")
+    class UMythicaWorldPartitionRegenerate* RegenerateWorldPartition(bool bForce = false);
+
+    UFUNCTION(BlueprintCallable, Category = "Mythica")
+    void CancelRegenerateAllComponents();
+
+    UFUNCTION(BlueprintPure, Category = "Mythica")
+    bool IsRegeneratingAllComponents() const;
+
     // Delegates
     UPROPERTY(BlueprintAssignable, Category = "Mythica")
     FOnSessionStateChanged OnSessionStateChanged;
@@ -368,6 +564,9 @@ public:
     UPROPERTY(BlueprintAssignable, Category = "Mythica")
     FOnJobStateChanged OnJobStateChange;
 
+    UPROPERTY(BlueprintAssignable, Category = "Mythica")
+    FOnJobUploadProgress OnJobUploadProgress;
+
     UPROPERTY(BlueprintAssignable, Category = "Mythica")
     FOnGenMeshAssetCreated OnGenAssetCreated;
 
@@ -386,9 +585,30 @@ private:
     void ExecuteFavoriteAsset(const FString& AssetId, bool State);
     void OnFavortiteAssetResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful);
 
-    bool PrepareInputFiles(const FMythicaParameters& Params, TMap<int, FString>& InputFiles, FString& ExportDirectory, const FVector& Origin);
-    void UploadInputFiles(int RequestId, const TMap<int, FString>& InputFiles);
-    void OnUploadInputFilesResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, int RequestId, const TMap<int, FString>& InputFiles);
+    bool PrepareInputFiles(const FMythicaParameters& Params, TArray<FMythicaInputExport>& OutExports, FString& ExportDirectory, const FVector& Origin, const TMap<int, FString>& UploadedInputs, FMythicaExportStats& OutStats);
+    void FindUploadedInputs(int RequestId, TMap<int, FString>& OutFileIds);
+    void SubmitJob(int RequestId, TArray<FMythicaInputExport>&& InputExports, const FString& ExportDirectory);
+    void OnInputFileExported(int RequestId, int InputIndex, const FString& FilePath, const FMythicaUploadData& Data, const FString& UploadKey);
+    void AddFileUpload(int RequestId, int InputIndex, const FString& FilePath, const FMythicaUploadData& Data);
+    void CompressFileUpload(int UploadId);
+    void OnFileUploadCompressed(int UploadId, const FMythicaUploadData& CompressedData, double Seconds);
+    void StartQueuedUploads();
+    void StartFileUpload(int UploadId);
+    void RetryFileUpload(int UploadId);
+    void OnFileUploadProgress(int UploadId, uint64 BytesSent);
+    void OnFileUploadResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, int UploadId);
+    void StartResumableUpload(int UploadId);
+    void OnResumableUploadStatus(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, int UploadId);
+    void SendUploadPart(int UploadId);
+    void OnUploadPartResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, int UploadId);
+    FMythicaFileUpload* FindActiveFileUpload(int UploadId);
+    void ReleaseUploadSlot();
+    void SetUploadOffset(FMythicaFileUpload& Upload, int64 Offset);
+    bool DisableUploadCompression(int UploadId, FHttpResponsePtr Response);
+    void FailFileUpload(int UploadId, const FString& Error);
+    void FinishFileUpload(int UploadId, const FString& FileId);
+    void OnInputFilesUploaded(int RequestId);
+    void CancelFileUploads(int RequestId);
     void SendJobRequest(int RequestId);
 
     void OnExecuteJobResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, int RequestId);
@@ -397,8 +617,27 @@ private:
     void OnMeshDownloadInfoResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, int RequestId);
     void OnMeshDownloadResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, int RequestId);
     void OnResultMeshData(const TArray<uint8>& FileData, int RequestId);
+    void ImportResultFile(const FString& FilePath, int RequestId);
+    FString MakeResultImportFilePath(const FMythicaJob& Job) const;
+
+    bool HasCachedResult(const FString& Fingerprint);
+    void ResolveJobFromCache(int RequestId);
+    void RequestSharedResult(int RequestId);
+    void OnSharedResultResponse(bool bHit, const TArray<uint8>& FileData, int RequestId);
+    void PrepareAndSubmitJob(int RequestId);
+
+    bool WaitForSharedInputs(int RequestId);
+    void OnSharedInputsUploaded(int RequestId);
+    void ReleaseSharedInputs(int RequestId);
+
+    int FindInFlightJob(const FString& Fingerprint) const;
+    void SyncFollowerState(int RequestId, FText Message);
 
-    int CreateJob(const FString& JobDefId, const FMythicaParameters& Params, const FString& ImportName, UMythicaComponent* Component);
+    void StopJob(int RequestId);
+    void SendCancelJobRequest(const FString& JobId);
+    void OnCancelJobResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, FString JobId);
+
+    int CreateJob(const FString& JobDefId, const FMythicaParameters& Params, const FString& ImportName, const FVector& Origin, const FString& Fingerprint, UMythicaComponent* Component);
     void SetJobState(int RequestId, EMythicaJobState State, FText Message = FText::GetEmpty());
     void PollJobStatus();
     void OnJobTimeout(int RequestId);
@@ -441,10 +680,32 @@ private:
     FTimerHandle JobPollTimer;
     int NextRequestId = 1;
 
+    FMythicaResultCache ResultCache;
+    FMythicaUploadCache UploadCache;
+
+    TMap<FGuid, FMythicaSharedInputs> SharedInputs;
+
+    TMap<int, FMythicaFileUpload> FileUploads;
+    TArray<int> QueuedUploadIds;
+    int NextUploadId = 1;
+    int ActiveUploads = 0;
+
+    /** Cleared when the service rejects compressed uploads, inputs are sent uncompressed for the rest of the session */
+    bool UploadCompressionSupported = true;
+
     TMap<FString, FString> InstalledAssets;
     TArray<FMythicaAsset> AssetList;
     FMythicaStats Stats;
 
     UPROPERTY()
     TMap<FString, UTexture2D*> ThumbnailCache;
+
+    UPROPERTY()
+    TObjectPtr<class UMythicaBulkRegenerate> BulkRegenerate = nullptr;
+
+    UPROPERTY()
+    TObjectPtr<class UMythicaWorldPartitionRegenerate> WorldPartitionRegenerate = nullptr;
+
+    UPROPERTY()
+    TArray<TObjectPtr<class UMythicaVariantBatch>> VariantBatches;
 };
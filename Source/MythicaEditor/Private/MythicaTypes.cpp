@@ -395,3 +395,91 @@ void Mythica::CopyParameterValues(const FMythicaParameters& Source, FMythicaPara
         }
     }
 }
+
+bool Mythica::SetParameterValue(FMythicaParameters& Parameters, const FString& Name, const FString& Value)
+{
+    FMythicaParameter* Param = Parameters.Parameters.FindByPredicate([&Name](const FMythicaParameter& P) { return P.Name == Name; });
+    if (!Param)
+    {
+        return false;
+    }
+
+    TArray<FString> Elements;
+    Value.ParseIntoArray(Elements, TEXT(","));
+    for (FString& Element : Elements)
+    {
+        Element.TrimStartAndEndInline();
+    }
+
+    switch (Param->Type)
+    {
+        case EMythicaParameterType::Int:
+        {
+            TArray<int> Values;
+            for (const FString& Element : Elements)
+            {
+                if (!Element.IsNumeric())
+                {
+                    return false;
+                }
+                Values.Add(FCString::Atoi(*Element));
+            }
+
+            if (!Param->ValueInt.Validate(Values))
+            {
+                return false;
+            }
+
+            Param->ValueInt.Values = Values;
+            return true;
+        }
+        case EMythicaParameterType::Float:
+        {
+            TArray<float> Values;
+            for (const FString& Element : Elements)
+            {
+                if (!Element.IsNumeric())
+                {
+                    return false;
+                }
+                Values.Add(FCString::Atof(*Element));
+            }
+
+            if (!Param->ValueFloat.Validate(Values))
+            {
+                return false;
+            }
+
+            Param->ValueFloat.Values = Values;
+            return true;
+        }
+        case EMythicaParameterType::Bool:
+        {
+            Param->ValueBool.Value = Value.TrimStartAndEnd().ToBool();
+            return true;
+        }
+        case EMythicaParameterType::String:
+        {
+            Param->ValueString.Value = Value;
+            return true;
+        }
+        case EMythicaParameterType::Enum:
+        {
+            FString EnumValue = Value.TrimStartAndEnd();
+            if (!Param->ValueEnum.Validate(EnumValue))
+            {
+                return false;
+            }
+
+            Param->ValueEnum.Value = EnumValue;
+            return true;
+        }
+        case EMythicaParameterType::File:
+        {
+            // Inputs are shared by all variants
+            return false;
+        }
+    }
+
+    return false;
+}
@@ -142,6 +142,20 @@ struct FMythicaParameterFileSettings
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
     EMythicaExportTransformType TransformType = EMythicaExportTransformType::Relative;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    EMythicaExportProfile ExportProfile = EMythicaExportProfile::Full;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    EMythicaExportFormat ExportFormat = EMythicaExportFormat::Usdz;
+
+    /** Level of detail exported for static meshes, clamped to each mesh's lowest LOD */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0"))
+    int32 MeshLOD = 0;
+
+    /** Static meshes with more triangles are simplified down to this many, without materials. 0 exports them as they are. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0"))
+    int32 MeshTriangleBudget = 0;
 };
 
 USTRUCT(BlueprintType)
@@ -212,6 +226,32 @@ struct FMythicaParameters
     TArray<FMythicaParameter> Parameters;
 };
 
+/** Value of a single parameter in a variant, lists are comma separated */
+USTRUCT(BlueprintType)
+struct FMythicaParameterOverride
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FString Name;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FString Value;
+};
+
+/** A named set of parameter values applied on top of a component's parameters */
+USTRUCT(BlueprintType)
+struct FMythicaParameterVariant
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FString Name;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    TArray<FMythicaParameterOverride> Overrides;
+};
+
 USTRUCT(BlueprintType)
 struct FMythicaMaterialParameters
 {
@@ -228,4 +268,7 @@ namespace Mythica
     void ReadParameters(const TSharedPtr<FJsonObject>& ParamsSchema, FMythicaParameters& OutParameters);
     void WriteParameters(const TArray<FString>& InputFileIds, const FMythicaParameters& Parameters, const TSharedPtr<FJsonObject>& ParameterSet);
     void CopyParameterValues(const FMythicaParameters& Source, FMythicaParameters& Target);
+
+    /** Parses the value into the named parameter, fails if the parameter is unknown or the value is invalid */
+    bool SetParameterValue(FMythicaParameters& Parameters, const FString& Name, const FString& Value);
 }
@@ -1,21 +1,32 @@
-#pragma once
-
 #include "MythicaUSDUtil.h"
 
 #include "AssetImportTask.h"
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "AssetToolsModule.h"
 #include "AutomatedAssetImportData.h"
+#include "Components/InstancedStaticMeshComponent.h"
 #include "Components/SplineComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "DynamicMesh/DynamicMesh3.h"
+#include "DynamicMesh/DynamicMeshAttributeSet.h"
 #include "Exporters/Exporter.h"
-#include "IPythonScriptPlugin.h"
-#include "LevelExporterUSDOptions.h"
-#include "Selection.h"
+#include "HAL/FileManager.h"
+#include "Hash/Blake3.h"
+#include "IO/IoHash.h"
+#include "Jobs/MythicaJobFingerprint.h"
+#include "Jobs/MythicaUploadCompression.h"
+#include "MeshSimplification.h"
+#include "Misc/FileHelper.h"
+#include "MythicaCompactMesh.h"
+#include "MythicaDeveloperSettings.h"
 #include "Serialization/ArchiveReplaceObjectRef.h"
 #include "StaticMeshExporterUSDOptions.h"
+#include "StaticMeshResources.h"
 #include "UObject/GCObjectScopeGuard.h"
 #include "UnrealUSDWrapper.h"
 #include "USDConversionUtils.h"
+#include "USDGeomMeshConversion.h"
+#include "USDMemory.h"
 #include "USDStageImportOptions.h"
 #include "USDTypesConversion.h"
 #include "UsdWrappers/SdfLayer.h"
@@ -23,50 +34,1136 @@
 #include "UsdWrappers/UsdStage.h"
 
 #include "USDIncludesStart.h"
+    #include "pxr/base/gf/transform.h"
+    #include "pxr/base/tf/stringUtils.h"
+    #include "pxr/usd/sdf/layer.h"
+    #include "pxr/usd/usd/primRange.h"
     #include "pxr/usd/usd/stage.h"
     #include "pxr/usd/usdGeom/basisCurves.h"
+    #include "pxr/usd/usdGeom/mesh.h"
+    #include "pxr/usd/usdGeom/pointInstancer.h"
+    #include "pxr/usd/usdGeom/primvarsAPI.h"
+    #include "pxr/usd/usdGeom/subset.h"
+    #include "pxr/usd/usdGeom/xform.h"
+    #include "pxr/usd/usdGeom/xformCache.h"
+    #include "pxr/usd/usdUtils/dependencies.h"
 #include "USDIncludesEnd.h"
 
+THIRD_PARTY_INCLUDES_START
+#include "zlib.h"
+THIRD_PARTY_INCLUDES_END
+
 #include "MythicaEditorPrivatePCH.h"
 
-static bool ConvertUSDtoUSDZ(const FString& InFile, const FString& OutFile)
-{
-    if (!IPythonScriptPlugin::Get()->IsPythonAvailable())
+static bool ConvertUSDtoUSDZ(const FString& InFile, const FString& OutFile)
+{
+    FScopedUsdAllocs UsdAllocs;
+
+    // Packages the layer and everything it references into a single archive
+    FString InFullPath = FPaths::ConvertRelativePathToFull(InFile);
+    FString OutFullPath = FPaths::ConvertRelativePathToFull(OutFile);
+    if (!pxr::UsdUtilsCreateNewUsdzPackage(pxr::SdfAssetPath(TCHAR_TO_UTF8(*InFullPath)), TCHAR_TO_UTF8(*OutFullPath)))
+    {
+        UE_LOG(LogMythicaEditor, Error, TEXT("Failed to package %s as USDZ"), *InFile);
+        return false;
+    }
+
+    return true;
+}
+
+static int64 GetAttributeDataSize(const pxr::UsdAttribute& Attribute)
+{
+    pxr::VtValue Value;
+    if (!Attribute || !Attribute.Get(&Value))
+    {
+        return 0;
+    }
+
+    size_t ElementSize = Attribute.GetTypeName().GetScalarType().GetType().GetSizeof();
+    return (int64)(Value.IsArrayValued() ? Value.GetArraySize() : 1) * ElementSize;
+}
+
+static void StripToGeometry(pxr::UsdPrim& MeshPrim, int64& StrippedBytes)
+{
+    // Material assignments are authored on the mesh and on one subset per section
+    static const pxr::TfToken MaterialAttributeName("unrealMaterial");
+    static const pxr::TfToken MaterialBindingFamily("materialBind");
+
+    TArray<pxr::SdfPath> SubsetPaths;
+    for (const pxr::UsdPrim& Child : MeshPrim.GetChildren())
+    {
+        pxr::UsdGeomSubset Subset(Child);
+        pxr::TfToken FamilyName;
+        if (Subset && Subset.GetFamilyNameAttr().Get(&FamilyName) && FamilyName == MaterialBindingFamily)
+        {
+            StrippedBytes += GetAttributeDataSize(Subset.GetIndicesAttr());
+            SubsetPaths.Add(Child.GetPath());
+        }
+    }
+
+    for (const pxr::SdfPath& SubsetPath : SubsetPaths)
+    {
+        MeshPrim.GetStage()->RemovePrim(SubsetPath);
+    }
+
+    MeshPrim.RemoveProperty(MaterialAttributeName);
+    for (const pxr::UsdProperty& Property : MeshPrim.GetProperties())
+    {
+        if (pxr::TfStringStartsWith(Property.GetName().GetString(), "material:binding"))
+        {
+            MeshPrim.RemoveProperty(Property.GetName());
+        }
+    }
+
+    // Tools read the first UV set, the others are only used by materials and lightmaps
+    static const pxr::TfToken PrimaryUVSetName("st");
+
+    pxr::UsdGeomPrimvarsAPI PrimvarsAPI(MeshPrim);
+    for (const pxr::UsdGeomPrimvar& Primvar : PrimvarsAPI.GetPrimvars())
+    {
+        if (Primvar.GetTypeName().GetRole() != pxr::SdfValueRoleNames->TextureCoordinate || Primvar.GetPrimvarName() == PrimaryUVSetName)
+        {
+            continue;
+        }
+
+        StrippedBytes += GetAttributeDataSize(Primvar.GetAttr()) + GetAttributeDataSize(Primvar.GetIndicesAttr());
+        PrimvarsAPI.RemovePrimvar(Primvar.GetPrimvarName());
+    }
+}
+
+static int32 GetExportLOD(const UStaticMesh* Mesh, const FMythicaMeshExportOptions& Options)
+{
+    return FMath::Clamp(Options.LOD, 0, FMath::Max(Mesh->GetNumLODs() - 1, 0));
+}
+
+static bool ConvertMeshForExport(const UStaticMesh* Mesh, pxr::UsdPrim& MeshPrim, const FMythicaMeshExportOptions& Options, int64& StrippedBytes)
+{
+    // A single LOD is written straight onto the prim instead of into a LOD variant set
+    int32 LOD = GetExportLOD(Mesh, Options);
+    if (!MeshPrim || !UnrealToUsd::ConvertStaticMesh(Mesh, MeshPrim, pxr::UsdTimeCode::Default(), nullptr, LOD, LOD))
+    {
+        UE_LOG(LogMythicaEditor, Error, TEXT("Failed to convert static mesh %s"), *Mesh->GetName());
+        return false;
+    }
+
+    if (Options.Profile == EMythicaExportProfile::GeometryOnly)
+    {
+        StripToGeometry(MeshPrim, StrippedBytes);
+    }
+
+    return true;
+}
+
+/** Triangles of a static mesh LOD, copied from its render data on the game thread and simplified when the input is written */
+struct FMythicaMeshSimplifyTask
+{
+    FString MeshPath;
+    FString MeshName;
+    int32 TriangleBudget = 0;
+
+    TArray<FVector3f> Positions;
+    TArray<FVector3f> Normals;
+    TArray<FVector2f> UVs;
+    TArray<uint32> Indices;
+};
+
+static bool NeedsSimplification(const UStaticMesh* Mesh, const FMythicaMeshExportOptions& Options)
+{
+    const FStaticMeshRenderData* RenderData = Mesh->GetRenderData();
+    int32 LOD = GetExportLOD(Mesh, Options);
+    return Options.TriangleBudget > 0 && RenderData && RenderData->LODResources.IsValidIndex(LOD)
+        && (int32)RenderData->LODResources[LOD].GetNumTriangles() > Options.TriangleBudget;
+}
+
+static void AddSimplifyTask(const UStaticMesh* Mesh, const FMythicaMeshExportOptions& Options, const pxr::SdfPath& MeshPath, TArray<FMythicaMeshSimplifyTask>& Tasks)
+{
+    const FStaticMeshLODResources& LODResources = Mesh->GetRenderData()->LODResources[GetExportLOD(Mesh, Options)];
+    const FStaticMeshVertexBuffer& VertexBuffer = LODResources.VertexBuffers.StaticMeshVertexBuffer;
+    int32 NumVertices = LODResources.GetNumVertices();
+
+    FMythicaMeshSimplifyTask& Task = Tasks.AddDefaulted_GetRef();
+    Task.MeshPath = UTF8_TO_TCHAR(MeshPath.GetString().c_str());
+    Task.MeshName = Mesh->GetName();
+    Task.TriangleBudget = Options.TriangleBudget;
+
+    Task.Positions.SetNumUninitialized(NumVertices);
+    Task.Normals.SetNumUninitialized(NumVertices);
+    if (VertexBuffer.GetNumTexCoords() > 0)
+    {
+        Task.UVs.SetNumUninitialized(NumVertices);
+    }
+
+    for (int32 i = 0; i < NumVertices; ++i)
+    {
+        Task.Positions[i] = LODResources.VertexBuffers.PositionVertexBuffer.VertexPosition(i);
+        Task.Normals[i] = FVector3f(VertexBuffer.VertexTangentZ(i));
+        if (!Task.UVs.IsEmpty())
+        {
+            Task.UVs[i] = VertexBuffer.GetVertexUV(i, 0);
+        }
+    }
+
+    LODResources.IndexBuffer.GetCopy(Task.Indices);
+}
+
+static void SimplifyMesh(const FMythicaMeshSimplifyTask& Task, UE::Geometry::FDynamicMesh3& OutMesh)
+{
+    using namespace UE::Geometry;
+
+    OutMesh.EnableAttributes();
+    FDynamicMeshUVOverlay* UVOverlay = OutMesh.Attributes()->PrimaryUV();
+    FDynamicMeshNormalOverlay* NormalOverlay = OutMesh.Attributes()->PrimaryNormals();
+
+    // Render vertices are split along UV and normal seams. They are welded by position so the simplifier sees
+    // a connected surface, the seams are kept in the overlays.
+    TMap<FVector3f, int32> WeldedVertices;
+    TArray<int32> VertexIds;
+    VertexIds.SetNumUninitialized(Task.Positions.Num());
+    for (int32 i = 0; i < Task.Positions.Num(); ++i)
+    {
+        int32* Existing = WeldedVertices.Find(Task.Positions[i]);
+        VertexIds[i] = Existing ? *Existing : WeldedVertices.Add(Task.Positions[i], OutMesh.AppendVertex(FVector3d(Task.Positions[i])));
+    }
+
+    auto AppendElements = [&Task, UVOverlay, NormalOverlay](const FIndex3i& Corners, FIndex3i& OutUVs, FIndex3i& OutNormals)
+    {
+        for (int32 c = 0; c < 3; ++c)
+        {
+            OutUVs[c] = UVOverlay->AppendElement(Task.UVs.IsEmpty() ? FVector2f::ZeroVector : Task.UVs[Corners[c]]);
+            OutNormals[c] = NormalOverlay->AppendElement(Task.Normals[Corners[c]]);
+        }
+    };
+
+    TArray<int32> UVElements;
+    TArray<int32> NormalElements;
+    UVElements.Init(INDEX_NONE, Task.Positions.Num());
+    NormalElements.Init(INDEX_NONE, Task.Positions.Num());
+
+    for (int32 i = 0; i + 2 < Task.Indices.Num(); i += 3)
+    {
+        FIndex3i Corners(Task.Indices[i], Task.Indices[i + 1], Task.Indices[i + 2]);
+        FIndex3i Triangle(VertexIds[Corners.A], VertexIds[Corners.B], VertexIds[Corners.C]);
+        if (Triangle.A == Triangle.B || Triangle.B == Triangle.C || Triangle.C == Triangle.A)
+        {
+            continue;
+        }
+
+        FIndex3i UVTriangle;
+        FIndex3i NormalTriangle;
+
+        int32 TriangleId = OutMesh.AppendTriangle(Triangle);
+        if (TriangleId == FDynamicMesh3::NonManifoldID)
+        {
+            // Triangles on non-manifold edges get their own vertices and elements
+            for (int32 c = 0; c < 3; ++c)
+            {
+                Triangle[c] = OutMesh.AppendVertex(FVector3d(Task.Positions[Corners[c]]));
+            }
+            TriangleId = OutMesh.AppendTriangle(Triangle);
+            AppendElements(Corners, UVTriangle, NormalTriangle);
+        }
+        else
+        {
+            for (int32 c = 0; c < 3; ++c)
+            {
+                int32 Corner = Corners[c];
+                if (UVElements[Corner] == INDEX_NONE)
+                {
+                    UVElements[Corner] = UVOverlay->AppendElement(Task.UVs.IsEmpty() ? FVector2f::ZeroVector : Task.UVs[Corner]);
+                    NormalElements[Corner] = NormalOverlay->AppendElement(Task.Normals[Corner]);
+                }
+                UVTriangle[c] = UVElements[Corner];
+                NormalTriangle[c] = NormalElements[Corner];
+            }
+        }
+
+        if (TriangleId >= 0)
+        {
+            UVOverlay->SetTriangle(TriangleId, UVTriangle);
+            NormalOverlay->SetTriangle(TriangleId, NormalTriangle);
+        }
+    }
+
+    int32 SourceTriangles = OutMesh.TriangleCount();
+
+    FQEMSimplification Simplifier(&OutMesh);
+    Simplifier.SimplifyToTriangleCount(Task.TriangleBudget);
+
+    UE_LOG(LogMythicaEditor, Verbose, TEXT("Simplified %s from %d to %d triangles"), *Task.MeshName, SourceTriangles, OutMesh.TriangleCount());
+}
+
+static bool AuthorSimplifiedMesh(const pxr::UsdStageRefPtr& Stage, const FUsdStageInfo& StageInfo, const FMythicaMeshSimplifyTask& Task)
+{
+    using namespace UE::Geometry;
+
+    FDynamicMesh3 Mesh;
+    SimplifyMesh(Task, Mesh);
+
+    const FDynamicMeshUVOverlay* UVOverlay = Mesh.Attributes()->PrimaryUV();
+    const FDynamicMeshNormalOverlay* NormalOverlay = Mesh.Attributes()->PrimaryNormals();
+
+    pxr::UsdGeomMesh UsdMesh = pxr::UsdGeomMesh::Get(Stage, pxr::SdfPath(TCHAR_TO_UTF8(*Task.MeshPath)));
+    if (!UsdMesh)
+    {
+        UE_LOG(LogMythicaEditor, Error, TEXT("Failed to find simplified mesh prim for %s"), *Task.MeshName);
+        return false;
+    }
+
+    // The simplifier leaves gaps in the vertex and element ids
+    TArray<int32> PointIndices;
+    PointIndices.Init(INDEX_NONE, Mesh.MaxVertexID());
+    pxr::VtArray<pxr::GfVec3f> Points;
+    Points.reserve(Mesh.VertexCount());
+    for (int32 VertexId : Mesh.VertexIndicesItr())
+    {
+        PointIndices[VertexId] = (int32)Points.size();
+        Points.push_back(UnrealToUsd::ConvertVectorFloat(StageInfo, FVector(Mesh.GetVertex(VertexId))));
+    }
+
+    TArray<int32> UVIndices;
+    UVIndices.Init(INDEX_NONE, UVOverlay->MaxElementID());
+    pxr::VtArray<pxr::GfVec2f> UVs;
+    for (int32 ElementId : UVOverlay->ElementIndicesItr())
+    {
+        FVector2f UV = UVOverlay->GetElement(ElementId);
+        UVIndices[ElementId] = (int32)UVs.size();
+        UVs.push_back(pxr::GfVec2f(UV.X, 1.0f - UV.Y));
+    }
+
+    pxr::VtArray<int> FaceVertexCounts(Mesh.TriangleCount(), 3);
+    pxr::VtArray<int> FaceVertexIndices;
+    pxr::VtArray<int> FaceUVIndices;
+    pxr::VtArray<pxr::GfVec3f> Normals;
+    FaceVertexIndices.reserve(Mesh.TriangleCount() * 3);
+    FaceUVIndices.reserve(Mesh.TriangleCount() * 3);
+    Normals.reserve(Mesh.TriangleCount() * 3);
+
+    for (int32 TriangleId : Mesh.TriangleIndicesItr())
+    {
+        FIndex3i Triangle = Mesh.GetTriangle(TriangleId);
+        FIndex3i UVTriangle = UVOverlay->GetTriangle(TriangleId);
+        FIndex3i NormalTriangle = NormalOverlay->GetTriangle(TriangleId);
+
+        for (int32 c = 0; c < 3; ++c)
+        {
+            FaceVertexIndices.push_back(PointIndices[Triangle[c]]);
+            FaceUVIndices.push_back(UVTriangle[c] >= 0 ? UVIndices[UVTriangle[c]] : 0);
+
+            FVector3f Normal = NormalTriangle[c] >= 0 ? NormalOverlay->GetElement(NormalTriangle[c]) : FVector3f::UpVector;
+            Normals.push_back(UnrealToUsd::ConvertVectorFloat(StageInfo, FVector(Normal)).GetNormalized());
+        }
+    }
+
+    pxr::VtArray<pxr::GfVec3f> Extent(2);
+    pxr::UsdGeomPointBased::ComputeExtent(Points, &Extent);
+
+    UsdMesh.CreateSubdivisionSchemeAttr().Set(pxr::UsdGeomTokens->none);
+    UsdMesh.CreatePointsAttr().Set(Points);
+    UsdMesh.CreateExtentAttr().Set(Extent);
+    UsdMesh.CreateFaceVertexCountsAttr().Set(FaceVertexCounts);
+    UsdMesh.CreateFaceVertexIndicesAttr().Set(FaceVertexIndices);
+    UsdMesh.CreateNormalsAttr().Set(Normals);
+    UsdMesh.SetNormalsInterpolation(pxr::UsdGeomTokens->faceVarying);
+
+    if (!Task.UVs.IsEmpty())
+    {
+        pxr::UsdGeomPrimvar UVPrimvar = pxr::UsdGeomPrimvarsAPI(UsdMesh.GetPrim()).CreatePrimvar(pxr::TfToken("st"), pxr::SdfValueTypeNames->TexCoord2fArray, pxr::UsdGeomTokens->faceVarying);
+        UVPrimvar.Set(UVs);
+        UVPrimvar.SetIndices(FaceUVIndices);
+    }
+
+    return true;
+}
+
+/** Authors a mesh for export at MeshPath, meshes over the triangle budget are only defined and filled in by the writer */
+static bool AuthorExportMesh(const pxr::UsdStageRefPtr& Stage, const pxr::SdfPath& MeshPath, const UStaticMesh* Mesh, const FMythicaMeshExportOptions& Options, int64& StrippedBytes, TArray<FMythicaMeshSimplifyTask>& SimplifyTasks)
+{
+    pxr::UsdPrim MeshPrim = pxr::UsdGeomMesh::Define(Stage, MeshPath).GetPrim();
+    if (!NeedsSimplification(Mesh, Options))
+    {
+        return ConvertMeshForExport(Mesh, MeshPrim, Options, StrippedBytes);
+    }
+
+    if (!MeshPrim)
+    {
+        UE_LOG(LogMythicaEditor, Error, TEXT("Failed to define simplified mesh for %s"), *Mesh->GetName());
+        return false;
+    }
+
+    AddSimplifyTask(Mesh, Options, MeshPath, SimplifyTasks);
+    return true;
+}
+
+// Bump when the exported meshes change so stale cached exports aren't reused
+const int ExportLayerCacheVersion = 1;
+
+static FString GetExportLayerCacheDirectory()
+{
+    return FPaths::ConvertRelativePathToFull(FPaths::Combine(FPaths::ProjectIntermediateDir(), TEXT("MythicaCache"), TEXT("LayerCache")));
+}
+
+/**
+ * Location of a mesh's cached export, the derived data key in the content key changes with the source mesh and its build settings.
+ * Full exports carry the material assignments, so they are part of the key too.
+ */
+static FString GetExportCachePath(const UStaticMesh* Mesh, const FMythicaMeshExportOptions& Options, const FString& Extension)
+{
+    FString MaterialKey = Options.Profile != EMythicaExportProfile::GeometryOnly ? Mythica::GetStaticMeshMaterialKey(Mesh) : FString();
+    FString Key = FString::Printf(TEXT("%s:%s:%d:%d:%d:%d:%s"), *Mythica::GetStaticMeshContentKey(Mesh), *MaterialKey, (int)Options.Profile, GetExportLOD(Mesh, Options), Options.TriangleBudget, ExportLayerCacheVersion, *Extension);
+    FTCHARToUTF8 KeyUtf8(*Key);
+    FString Hash = LexToString(FIoHash(FBlake3::HashBuffer(KeyUtf8.Get(), KeyUtf8.Length())));
+
+    return FPaths::Combine(GetExportLayerCacheDirectory(), Hash + TEXT(".") + Extension);
+}
+
+static FString MakeExportCacheTempPath(const FString& CachePath)
+{
+    return FPaths::Combine(FPaths::GetPath(CachePath), FString::Printf(TEXT("%s.%s.%s"), *FPaths::GetBaseFilename(CachePath), *FGuid::NewGuid().ToString(), *FPaths::GetExtension(CachePath)));
+}
+
+static bool FindCachedExport(const FString& CachePath)
+{
+    if (!IFileManager::Get().FileExists(*CachePath))
+    {
+        return false;
+    }
+
+    // Keeps exports that are still in use from being trimmed
+    IFileManager::Get().SetTimeStamp(*CachePath, FDateTime::UtcNow());
+    return true;
+}
+
+static bool GetCachedMeshLayer(const UStaticMesh* Mesh, const FMythicaMeshExportOptions& Options, FString& OutLayerPath, int64& StrippedBytes)
+{
+    OutLayerPath = GetExportCachePath(Mesh, Options, TEXT("usdc"));
+    if (FindCachedExport(OutLayerPath))
+    {
+        return true;
+    }
+
+    // Author into a temporary file first so an interrupted export never leaves a partial layer behind
+    FString TempPath = MakeExportCacheTempPath(OutLayerPath);
+    bool Success = false;
+    {
+        UE::FUsdStage Stage = UnrealUSDWrapper::NewStage(*TempPath);
+        if (Stage)
+        {
+            UsdUtils::SetUsdStageMetersPerUnit(Stage, 1.0f);
+            UsdUtils::SetUsdStageUpAxis(Stage, pxr::TfToken("Y"));
+
+            FScopedUsdAllocs UsdAllocs;
+
+            pxr::UsdStageRefPtr UsdStage(Stage);
+            pxr::SdfPath PrototypePath("/Prototype");
+            UsdStage->SetDefaultPrim(pxr::UsdGeomXform::Define(UsdStage, PrototypePath).GetPrim());
+
+            pxr::UsdPrim MeshPrim = pxr::UsdGeomMesh::Define(UsdStage, PrototypePath.AppendChild(pxr::TfToken("Mesh"))).GetPrim();
+            Success = ConvertMeshForExport(Mesh, MeshPrim, Options, StrippedBytes) && Stage.GetRootLayer().Save();
+        }
+    }
+
+    if (!Success || !IFileManager::Get().Move(*OutLayerPath, *TempPath))
+    {
+        UE_LOG(LogMythicaEditor, Error, TEXT("Failed to write cached layer for %s"), *Mesh->GetName());
+        IFileManager::Get().Delete(*TempPath, false, true, true);
+        return false;
+    }
+
+    return true;
+}
+
+void Mythica::TrimExportLayerCache(double ExpirySeconds)
+{
+    FDateTime Now = FDateTime::UtcNow();
+
+    TArray<FString> ExpiredFiles;
+    IFileManager::Get().IterateDirectoryStat(*GetExportLayerCacheDirectory(), [&](const TCHAR* FilePath, const FFileStatData& StatData)
+    {
+        if (!StatData.bIsDirectory && (Now - StatData.ModificationTime).GetTotalSeconds() > ExpirySeconds)
+        {
+            ExpiredFiles.Add(FilePath);
+        }
+        return true;
+    });
+
+    for (const FString& FilePath : ExpiredFiles)
+    {
+        IFileManager::Get().Delete(*FilePath, false, true, true);
+    }
+
+    if (!ExpiredFiles.IsEmpty())
+    {
+        UE_LOG(LogMythicaEditor, Verbose, TEXT("Removed %d expired mesh exports from the export cache"), ExpiredFiles.Num());
+    }
+}
+
+struct FMythicaActorExportContext
+{
+    pxr::UsdStageRefPtr Stage;
+    FUsdStageInfo StageInfo;
+    FVector Origin;
+    FMythicaMeshExportOptions Options;
+    bool UseLayerCache = false;
+    int64 StrippedBytes = 0;
+    TArray<FMythicaMeshSimplifyTask> SimplifyTasks;
+
+    pxr::SdfPath PrototypesPath;
+    TMap<const UStaticMesh*, pxr::SdfPath> Prototypes;
+};
+
+static pxr::SdfPath MakeUniqueChildPath(const pxr::SdfPath& ParentPath, const FString& Name, TSet<FString>& UsedNames)
+{
+    FString BaseName = UTF8_TO_TCHAR(pxr::TfMakeValidIdentifier(TCHAR_TO_UTF8(*Name)).c_str());
+    FString UniqueName = BaseName;
+    for (int Suffix = 1; UsedNames.Contains(UniqueName); ++Suffix)
+    {
+        UniqueName = FString::Printf(TEXT("%s_%d"), *BaseName, Suffix);
+    }
+
+    UsedNames.Add(UniqueName);
+    return ParentPath.AppendChild(pxr::TfToken(TCHAR_TO_UTF8(*UniqueName)));
+}
+
+static FTransform MakeExportTransform(const FMythicaActorExportContext& Context, const FTransform& WorldTransform)
+{
+    FTransform Transform = WorldTransform;
+    Transform.SetLocation(Transform.GetLocation() - Context.Origin);
+    return Transform;
+}
+
+static bool GetStaticMeshPrototype(FMythicaActorExportContext& Context, const UStaticMesh* Mesh, pxr::SdfPath& OutPath)
+{
+    if (const pxr::SdfPath* Existing = Context.Prototypes.Find(Mesh))
+    {
+        OutPath = *Existing;
+        return true;
+    }
+
+    // Each mesh is authored once under an abstract class prim and referenced by every component using it
+    if (Context.PrototypesPath.IsEmpty())
+    {
+        Context.PrototypesPath = pxr::SdfPath("/Prototypes");
+        Context.Stage->CreateClassPrim(Context.PrototypesPath);
+    }
+
+    TSet<FString> UsedNames;
+    for (const TPair<const UStaticMesh*, pxr::SdfPath>& Prototype : Context.Prototypes)
+    {
+        UsedNames.Add(UTF8_TO_TCHAR(Prototype.Value.GetName().c_str()));
+    }
+
+    pxr::SdfPath PrototypePath = MakeUniqueChildPath(Context.PrototypesPath, Mesh->GetName(), UsedNames);
+    pxr::UsdPrim PrototypePrim = pxr::UsdGeomXform::Define(Context.Stage, PrototypePath).GetPrim();
+
+    // Cached meshes are only converted when their content changed, the stage just references their layer.
+    // Simplified meshes are authored in the stage since they are only built when the input is written.
+    if (Context.UseLayerCache && !NeedsSimplification(Mesh, Context.Options))
+    {
+        FString LayerPath;
+        if (!GetCachedMeshLayer(Mesh, Context.Options, LayerPath, Context.StrippedBytes))
+        {
+            return false;
+        }
+
+        if (!PrototypePrim.GetReferences().AddReference(TCHAR_TO_UTF8(*LayerPath)))
+        {
+            UE_LOG(LogMythicaEditor, Error, TEXT("Failed to reference cached layer for %s"), *Mesh->GetName());
+            return false;
+        }
+    }
+    else
+    {
+        pxr::SdfPath MeshPath = PrototypePath.AppendChild(pxr::TfToken("Mesh"));
+        if (!AuthorExportMesh(Context.Stage, MeshPath, Mesh, Context.Options, Context.StrippedBytes, Context.SimplifyTasks))
+        {
+            return false;
+        }
+    }
+
+    Context.Prototypes.Add(Mesh, PrototypePath);
+    OutPath = PrototypePath;
+    return true;
+}
+
+static bool ExportStaticMeshComponent(FMythicaActorExportContext& Context, const UStaticMeshComponent* Component, const pxr::SdfPath& Path)
+{
+    pxr::SdfPath PrototypePath;
+    if (!GetStaticMeshPrototype(Context, Component->GetStaticMesh(), PrototypePath))
+    {
+        return false;
+    }
+
+    pxr::UsdGeomXform Xform = pxr::UsdGeomXform::Define(Context.Stage, Path);
+    pxr::UsdPrim Prim = Xform.GetPrim();
+    if (!Prim || !Prim.GetReferences().AddInternalReference(PrototypePath))
+    {
+        UE_LOG(LogMythicaEditor, Error, TEXT("Failed to reference mesh for %s"), *Component->GetName());
+        return false;
+    }
+    Prim.SetInstanceable(true);
+
+    FTransform Transform = MakeExportTransform(Context, Component->GetComponentTransform());
+    Xform.AddTransformOp().Set(UnrealToUsd::ConvertTransform(Context.StageInfo, Transform));
+    return true;
+}
+
+static bool ExportInstancedStaticMeshComponent(FMythicaActorExportContext& Context, const UInstancedStaticMeshComponent* Component, const pxr::SdfPath& Path)
+{
+    pxr::SdfPath PrototypePath;
+    if (!GetStaticMeshPrototype(Context, Component->GetStaticMesh(), PrototypePath))
+    {
+        return false;
+    }
+
+    pxr::UsdGeomPointInstancer Instancer = pxr::UsdGeomPointInstancer::Define(Context.Stage, Path);
+    if (!Instancer)
+    {
+        UE_LOG(LogMythicaEditor, Error, TEXT("Failed to create instancer for %s"), *Component->GetName());
+        return false;
+    }
+
+    pxr::SdfPath InstancePrototypePath = Path.AppendChild(pxr::TfToken("Prototype"));
+    pxr::UsdPrim InstancePrototype = pxr::UsdGeomXform::Define(Context.Stage, InstancePrototypePath).GetPrim();
+    InstancePrototype.GetReferences().AddInternalReference(PrototypePath);
+    Instancer.CreatePrototypesRel().SetTargets({ InstancePrototypePath });
+
+    // Instances are written in export space so the instancer itself keeps an identity transform
+    int NumInstances = Component->GetInstanceCount();
+
+    pxr::VtArray<int> ProtoIndices(NumInstances, 0);
+    pxr::VtArray<pxr::GfVec3f> Positions;
+    pxr::VtArray<pxr::GfQuath> Orientations;
+    pxr::VtArray<pxr::GfVec3f> Scales;
+    Positions.reserve(NumInstances);
+    Orientations.reserve(NumInstances);
+    Scales.reserve(NumInstances);
+
+    for (int i = 0; i < NumInstances; ++i)
+    {
+        FTransform InstanceTransform;
+        Component->GetInstanceTransform(i, InstanceTransform, true);
+
+        pxr::GfTransform UsdTransform(UnrealToUsd::ConvertTransform(Context.StageInfo, MakeExportTransform(Context, InstanceTransform)));
+        Positions.push_back(pxr::GfVec3f(UsdTransform.GetTranslation()));
+        Orientations.push_back(pxr::GfQuath(UsdTransform.GetRotation().GetQuat()));
+        Scales.push_back(pxr::GfVec3f(UsdTransform.GetScale()));
+    }
+
+    Instancer.CreateProtoIndicesAttr().Set(ProtoIndices);
+    Instancer.CreatePositionsAttr().Set(Positions);
+    Instancer.CreateOrientationsAttr().Set(Orientations);
+    Instancer.CreateScalesAttr().Set(Scales);
+    return true;
+}
+
+static bool ExportActor(FMythicaActorExportContext& Context, const AActor* Actor, const pxr::SdfPath& Path)
+{
+    TInlineComponentArray<UStaticMeshComponent*> Components(Actor);
+    Components.RemoveAll([](const UStaticMeshComponent* Component) { return !Component->GetStaticMesh(); });
+    if (Components.IsEmpty())
+    {
+        return true;
+    }
+
+    pxr::UsdGeomXform::Define(Context.Stage, Path);
+
+    TSet<FString> UsedNames;
+    for (const UStaticMeshComponent* Component : Components)
+    {
+        pxr::SdfPath ComponentPath = MakeUniqueChildPath(Path, Component->GetName(), UsedNames);
+
+        bool Success = false;
+        if (const UInstancedStaticMeshComponent* InstancedComponent = Cast<UInstancedStaticMeshComponent>(Component))
+        {
+            Success = ExportInstancedStaticMeshComponent(Context, InstancedComponent, ComponentPath);
+        }
+        else
+        {
+            Success = ExportStaticMeshComponent(Context, Component, ComponentPath);
+        }
+
+        if (!Success)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+struct FMythicaUsdzEntry
+{
+    FString Name;
+    TArray64<uint8> Data;
+};
+
+// File data in a USDZ package starts at multiples of 64 bytes so it can be memory mapped
+const int64 UsdzAlignment = 64;
+
+// Extra field id USD uses to pad local file headers
+const uint16 UsdzPaddingFieldId = 0x1986;
+
+static void AppendLittleEndian(TArray64<uint8>& Out, uint32 Value, int32 NumBytes)
+{
+    for (int32 i = 0; i < NumBytes; ++i)
+    {
+        Out.Add((uint8)(Value >> (8 * i)));
+    }
+}
+
+static uint32 ComputeZipCrc(const TArray64<uint8>& Data)
+{
+    uLong Crc = crc32(0L, Z_NULL, 0);
+    for (int64 Offset = 0; Offset < Data.Num(); Offset += MAX_int32)
+    {
+        Crc = crc32(Crc, Data.GetData() + Offset, (uInt)FMath::Min<int64>(Data.Num() - Offset, MAX_int32));
+    }
+    return (uint32)Crc;
+}
+
+/** Writes a USDZ package, an uncompressed zip archive with aligned file data whose first file is the root layer */
+static bool WriteUsdzArchive(const TArray<FMythicaUsdzEntry>& Entries, TArray64<uint8>& OutData)
+{
+    // A fixed modification time keeps identical inputs byte identical for the upload cache
+    const uint32 DosTime = 0;
+    const uint32 DosDate = (1 << 5) | 1;
+
+    OutData.Reset();
+    TArray64<uint8> CentralDirectory;
+
+    for (const FMythicaUsdzEntry& Entry : Entries)
+    {
+        FTCHARToUTF8 Name(*Entry.Name);
+        int64 HeaderOffset = OutData.Num();
+
+        int64 Padding = (UsdzAlignment - (HeaderOffset + 30 + Name.Length()) % UsdzAlignment) % UsdzAlignment;
+        if (Padding > 0 && Padding < 4)
+        {
+            Padding += UsdzAlignment;
+        }
+
+        if (HeaderOffset + 30 + Name.Length() + Padding + Entry.Data.Num() > MAX_uint32)
+        {
+            UE_LOG(LogMythicaEditor, Error, TEXT("Export is too large to package as USDZ"));
+            return false;
+        }
+
+        uint32 Crc = ComputeZipCrc(Entry.Data);
+        uint32 DataSize = (uint32)Entry.Data.Num();
+
+        AppendLittleEndian(OutData, 0x04034b50, 4);
+        AppendLittleEndian(OutData, 10, 2);
+        AppendLittleEndian(OutData, 0, 2);
+        AppendLittleEndian(OutData, 0, 2);
+        AppendLittleEndian(OutData, DosTime, 2);
+        AppendLittleEndian(OutData, DosDate, 2);
+        AppendLittleEndian(OutData, Crc, 4);
+        AppendLittleEndian(OutData, DataSize, 4);
+        AppendLittleEndian(OutData, DataSize, 4);
+        AppendLittleEndian(OutData, Name.Length(), 2);
+        AppendLittleEndian(OutData, (uint32)Padding, 2);
+        OutData.Append((const uint8*)Name.Get(), Name.Length());
+        if (Padding > 0)
+        {
+            AppendLittleEndian(OutData, UsdzPaddingFieldId, 2);
+            AppendLittleEndian(OutData, (uint32)Padding - 4, 2);
+            OutData.AddZeroed(Padding - 4);
+        }
+        OutData.Append(Entry.Data);
+
+        AppendLittleEndian(CentralDirectory, 0x02014b50, 4);
+        AppendLittleEndian(CentralDirectory, 10, 2);
+        AppendLittleEndian(CentralDirectory, 10, 2);
+        AppendLittleEndian(CentralDirectory, 0, 2);
+        AppendLittleEndian(CentralDirectory, 0, 2);
+        AppendLittleEndian(CentralDirectory, DosTime, 2);
+        AppendLittleEndian(CentralDirectory, DosDate, 2);
+        AppendLittleEndian(CentralDirectory, Crc, 4);
+        AppendLittleEndian(CentralDirectory, DataSize, 4);
+        AppendLittleEndian(CentralDirectory, DataSize, 4);
+        AppendLittleEndian(CentralDirectory, Name.Length(), 2);
+        AppendLittleEndian(CentralDirectory, 0, 2);
+        AppendLittleEndian(CentralDirectory, 0, 2);
+        AppendLittleEndian(CentralDirectory, 0, 2);
+        AppendLittleEndian(CentralDirectory, 0, 2);
+        AppendLittleEndian(CentralDirectory, 0, 4);
+        AppendLittleEndian(CentralDirectory, (uint32)HeaderOffset, 4);
+        CentralDirectory.Append((const uint8*)Name.Get(), Name.Length());
+    }
+
+    int64 CentralDirectoryOffset = OutData.Num();
+    if (CentralDirectoryOffset + CentralDirectory.Num() > MAX_uint32 || Entries.Num() > MAX_uint16)
+    {
+        UE_LOG(LogMythicaEditor, Error, TEXT("Export is too large to package as USDZ"));
+        return false;
+    }
+    OutData.Append(CentralDirectory);
+
+    AppendLittleEndian(OutData, 0x06054b50, 4);
+    AppendLittleEndian(OutData, 0, 2);
+    AppendLittleEndian(OutData, 0, 2);
+    AppendLittleEndian(OutData, Entries.Num(), 2);
+    AppendLittleEndian(OutData, Entries.Num(), 2);
+    AppendLittleEndian(OutData, (uint32)CentralDirectory.Num(), 4);
+    AppendLittleEndian(OutData, (uint32)CentralDirectoryOffset, 4);
+    AppendLittleEndian(OutData, 0, 2);
+    return true;
+}
+
+/** Packages a stage authored in memory, along with the cached mesh layers it references */
+static bool PackageStage(const UE::FUsdStage& Stage, TArray64<uint8>& OutData)
+{
+    TArray<FMythicaUsdzEntry> Entries;
+    TMap<FString, FString> LayerFiles;
+    {
+        FScopedUsdAllocs UsdAllocs;
+
+        // Referenced layers are stored next to the root layer in the package, the references are made relative on a copy
+        pxr::SdfLayerRefPtr RootLayer = pxr::SdfLayer::CreateAnonymous(".usda");
+        RootLayer->TransferContent(pxr::UsdStageRefPtr(Stage)->GetRootLayer());
+
+        pxr::UsdUtilsModifyAssetPaths(RootLayer, [&LayerFiles](const std::string& AssetPath) -> std::string
+        {
+            if (AssetPath.empty())
+            {
+                return AssetPath;
+            }
+
+            FString FilePath = UTF8_TO_TCHAR(AssetPath.c_str());
+            FString PackagePath = FString(TEXT("Layers/")) + FPaths::GetCleanFilename(FilePath);
+            LayerFiles.Add(PackagePath, FilePath);
+            return std::string(TCHAR_TO_UTF8(*PackagePath));
+        });
+
+        std::string LayerText;
+        if (!RootLayer->ExportToString(&LayerText))
+        {
+            UE_LOG(LogMythicaEditor, Error, TEXT("Failed to serialize export stage"));
+            return false;
+        }
+
+        FMythicaUsdzEntry& RootEntry = Entries.AddDefaulted_GetRef();
+        RootEntry.Name = TEXT("Export.usda");
+        RootEntry.Data.Append((const uint8*)LayerText.data(), LayerText.size());
+    }
+
+    for (const TPair<FString, FString>& LayerFile : LayerFiles)
+    {
+        FMythicaUsdzEntry& Entry = Entries.AddDefaulted_GetRef();
+        Entry.Name = LayerFile.Key;
+        if (!FFileHelper::LoadFileToArray(Entry.Data, *LayerFile.Value))
+        {
+            UE_LOG(LogMythicaEditor, Error, TEXT("Failed to read referenced layer %s"), *LayerFile.Value);
+            return false;
+        }
+    }
+
+    return WriteUsdzArchive(Entries, OutData);
+}
+
+struct FMythicaCompactCorner
+{
+    int32 Point = 0;
+    FVector3f Normal = FVector3f::ZeroVector;
+    FVector2f UV = FVector2f::ZeroVector;
+
+    bool operator==(const FMythicaCompactCorner& Other) const
+    {
+        return Point == Other.Point && Normal == Other.Normal && UV == Other.UV;
+    }
+
+    friend uint32 GetTypeHash(const FMythicaCompactCorner& Corner)
+    {
+        return HashCombine(HashCombine(GetTypeHash(Corner.Point), GetTypeHash(Corner.Normal)), GetTypeHash(Corner.UV));
+    }
+};
+
+static size_t GetInterpolatedIndex(const pxr::TfToken& Interpolation, size_t Face, size_t Corner, size_t Point)
+{
+    if (Interpolation == pxr::UsdGeomTokens->faceVarying)
+    {
+        return Corner;
+    }
+    if (Interpolation == pxr::UsdGeomTokens->uniform)
+    {
+        return Face;
+    }
+    if (Interpolation == pxr::UsdGeomTokens->constant)
+    {
+        return 0;
+    }
+    return Point;
+}
+
+/** Triangulates a mesh into the compact mesh, splitting its points wherever their normal or UV differs between faces */
+static void AppendCompactMesh(const pxr::UsdGeomMesh& Mesh, const pxr::GfMatrix4d& Transform, FMythicaCompactMeshData& OutMesh, bool& OutHasNormals, bool& OutHasUVs)
+{
+    pxr::VtArray<pxr::GfVec3f> Points;
+    pxr::VtArray<int> FaceVertexCounts;
+    pxr::VtArray<int> FaceVertexIndices;
+    if (!Mesh.GetPointsAttr().Get(&Points) || !Mesh.GetFaceVertexCountsAttr().Get(&FaceVertexCounts) || !Mesh.GetFaceVertexIndicesAttr().Get(&FaceVertexIndices))
+    {
+        return;
+    }
+
+    pxr::VtArray<pxr::GfVec3f> Normals;
+    Mesh.GetNormalsAttr().Get(&Normals);
+    pxr::TfToken NormalsInterpolation = Mesh.GetNormalsInterpolation();
+
+    pxr::VtArray<pxr::GfVec2f> UVs;
+    pxr::TfToken UVInterpolation;
+    pxr::UsdGeomPrimvar UVPrimvar = pxr::UsdGeomPrimvarsAPI(Mesh.GetPrim()).GetPrimvar(pxr::TfToken("st"));
+    if (UVPrimvar && UVPrimvar.ComputeFlattened(&UVs))
+    {
+        UVInterpolation = UVPrimvar.GetInterpolation();
+    }
+
+    OutHasNormals |= !Normals.empty();
+    OutHasUVs |= !UVs.empty();
+
+    // Triangles are written counter clockwise, mirroring transforms and left handed meshes reverse the winding
+    pxr::TfToken Orientation;
+    Mesh.GetOrientationAttr().Get(&Orientation);
+    bool FlipWinding = (Orientation == pxr::UsdGeomTokens->leftHanded) != (Transform.GetDeterminant() < 0.0);
+    pxr::GfMatrix4d NormalTransform = Transform.GetInverse().GetTranspose();
+
+    TMap<FMythicaCompactCorner, uint32> Vertices;
+    TArray<uint32, TInlineAllocator<8>> FaceVertices;
+
+    size_t FaceStart = 0;
+    for (size_t Face = 0; Face < FaceVertexCounts.size(); FaceStart += FaceVertexCounts[Face], ++Face)
+    {
+        int Count = FaceVertexCounts[Face];
+        if (Count < 3 || FaceStart + Count > FaceVertexIndices.size())
+        {
+            continue;
+        }
+
+        FaceVertices.Reset();
+        for (int c = 0; c < Count; ++c)
+        {
+            size_t Corner = FaceStart + c;
+            int Point = FaceVertexIndices[Corner];
+            if (Point < 0 || (size_t)Point >= Points.size())
+            {
+                break;
+            }
+
+            FMythicaCompactCorner Key;
+            Key.Point = Point;
+
+            size_t NormalIndex = GetInterpolatedIndex(NormalsInterpolation, Face, Corner, Point);
+            if (NormalIndex < Normals.size())
+            {
+                pxr::GfVec3d Normal = NormalTransform.TransformDir(pxr::GfVec3d(Normals[NormalIndex])).GetNormalized();
+                Key.Normal = FVector3f(Normal[0], Normal[1], Normal[2]);
+            }
+
+            size_t UVIndex = GetInterpolatedIndex(UVInterpolation, Face, Corner, Point);
+            if (UVIndex < UVs.size())
+            {
+                Key.UV = FVector2f(UVs[UVIndex][0], UVs[UVIndex][1]);
+            }
+
+            uint32* Vertex = Vertices.Find(Key);
+            if (!Vertex)
+            {
+                pxr::GfVec3d Position = Transform.Transform(pxr::GfVec3d(Points[Point]));
+                OutMesh.Positions.Add(FVector3f(Position[0], Position[1], Position[2]));
+                OutMesh.Normals.Add(Key.Normal);
+                OutMesh.UVs.Add(Key.UV);
+                Vertex = &Vertices.Add(Key, OutMesh.Positions.Num() - 1);
+            }
+            FaceVertices.Add(*Vertex);
+        }
+
+        if (FaceVertices.Num() != Count)
+        {
+            continue;
+        }
+
+        for (int c = 1; c + 1 < Count; ++c)
+        {
+            OutMesh.Indices.Add(FaceVertices[0]);
+            OutMesh.Indices.Add(FaceVertices[FlipWinding ? c + 1 : c]);
+            OutMesh.Indices.Add(FaceVertices[FlipWinding ? c : c + 1]);
+        }
+    }
+}
+
+static void AppendCompactPointInstancer(const pxr::UsdGeomPointInstancer& Instancer, pxr::UsdGeomXformCache& XformCache, FMythicaCompactMeshData& OutMesh, bool& OutHasNormals, bool& OutHasUVs)
+{
+    // Masked instances are kept so the transforms stay aligned with the prototype indices
+    pxr::VtArray<pxr::GfMatrix4d> InstanceTransforms;
+    pxr::VtArray<int> ProtoIndices;
+    pxr::SdfPathVector PrototypePaths;
+    if (!Instancer.ComputeInstanceTransformsAtTime(&InstanceTransforms, pxr::UsdTimeCode::Default(), pxr::UsdTimeCode::Default(), pxr::UsdGeomPointInstancer::IncludeProtoXform, pxr::UsdGeomPointInstancer::IgnoreMask)
+        || !Instancer.GetProtoIndicesAttr().Get(&ProtoIndices) || !Instancer.GetPrototypesRel().GetTargets(&PrototypePaths))
+    {
+        return;
+    }
+
+    pxr::UsdStagePtr Stage = Instancer.GetPrim().GetStage();
+    pxr::GfMatrix4d InstancerTransform = XformCache.GetLocalToWorldTransform(Instancer.GetPrim());
+
+    for (size_t i = 0; i < InstanceTransforms.size() && i < ProtoIndices.size(); ++i)
+    {
+        if (ProtoIndices[i] < 0 || (size_t)ProtoIndices[i] >= PrototypePaths.size())
+        {
+            continue;
+        }
+
+        pxr::UsdPrim Prototype = Stage->GetPrimAtPath(PrototypePaths[ProtoIndices[i]]);
+        for (const pxr::UsdPrim& Prim : pxr::UsdPrimRange(Prototype, pxr::UsdTraverseInstanceProxies()))
+        {
+            if (!Prim.IsA<pxr::UsdGeomMesh>())
+            {
+                continue;
+            }
+
+            bool ResetsXformStack = false;
+            pxr::GfMatrix4d MeshTransform = Prim == Prototype ? pxr::GfMatrix4d(1.0) : XformCache.ComputeRelativeTransform(Prim, Prototype, &ResetsXformStack);
+            AppendCompactMesh(pxr::UsdGeomMesh(Prim), MeshTransform * InstanceTransforms[i] * InstancerTransform, OutMesh, OutHasNormals, OutHasUVs);
+        }
+    }
+}
+
+/** Merges every mesh on the stage into one triangle mesh in stage space, instances are expanded */
+static void FlattenStage(const pxr::UsdStageRefPtr& Stage, FMythicaCompactMeshData& OutMesh)
+{
+    bool HasNormals = false;
+    bool HasUVs = false;
+
+    pxr::UsdGeomXformCache XformCache;
+    pxr::UsdPrimRange Range = Stage->Traverse(pxr::UsdTraverseInstanceProxies());
+    for (auto It = Range.begin(); It != Range.end(); ++It)
+    {
+        if (It->IsA<pxr::UsdGeomPointInstancer>())
+        {
+            AppendCompactPointInstancer(pxr::UsdGeomPointInstancer(*It), XformCache, OutMesh, HasNormals, HasUVs);
+            It.PruneChildren();
+        }
+        else if (It->IsA<pxr::UsdGeomMesh>())
+        {
+            AppendCompactMesh(pxr::UsdGeomMesh(*It), XformCache.GetLocalToWorldTransform(*It), OutMesh, HasNormals, HasUVs);
+        }
+    }
+
+    if (!HasNormals)
+    {
+        OutMesh.Normals.Empty();
+    }
+    if (!HasUVs)
+    {
+        OutMesh.UVs.Empty();
+    }
+}
+
+static bool EncodeStage(const UE::FUsdStage& Stage, TArray64<uint8>& OutData)
+{
+    FMythicaCompactMeshData Mesh;
+    {
+        FScopedUsdAllocs UsdAllocs;
+        FlattenStage(pxr::UsdStageRefPtr(Stage), Mesh);
+    }
+
+    if (Mesh.Indices.IsEmpty())
     {
+        UE_LOG(LogMythicaEditor, Error, TEXT("Export has no triangles to encode"));
         return false;
     }
 
-    FString Command;
-    Command.Append(TEXT("from mythica import usd_util\n"));
-    Command.Appendf(TEXT("usd_util.convert_usd_to_usdz('%s', '%s')\n"), *InFile, *OutFile);
+    return Mythica::EncodeCompactMesh(Mesh, OutData);
+}
 
-    IPythonScriptPlugin::Get()->ExecPythonCommand(*Command);
-    return true;
+static FMythicaExportWriter MakeStageWriter(UE::FUsdStage&& Stage, TArray<FMythicaMeshSimplifyTask>&& SimplifyTasks = {}, EMythicaExportFormat Format = EMythicaExportFormat::Usdz)
+{
+    return [Stage = MoveTemp(Stage), SimplifyTasks = MoveTemp(SimplifyTasks), Format](TArray64<uint8>& OutData)
+    {
+        // Meshes are simplified here so the game thread only pays for copying their render data
+        if (!SimplifyTasks.IsEmpty())
+        {
+            FScopedUsdAllocs UsdAllocs;
+
+            pxr::UsdStageRefPtr UsdStage(Stage);
+            FUsdStageInfo StageInfo(Stage);
+            for (const FMythicaMeshSimplifyTask& Task : SimplifyTasks)
+            {
+                if (!AuthorSimplifiedMesh(UsdStage, StageInfo, Task))
+                {
+                    return false;
+                }
+            }
+        }
+
+        return Format == EMythicaExportFormat::CompactMesh ? EncodeStage(Stage, OutData) : PackageStage(Stage, OutData);
+    };
 }
 
-static bool CreateOffsetScene(const FString& InFile, const FString& OutFile, const FVector& Offset)
+static UE::FUsdStage AuthorMeshGeometry(UStaticMesh* Mesh, const FMythicaMeshExportOptions& Options, TArray<FMythicaMeshSimplifyTask>& OutSimplifyTasks, FMythicaExportStats* OutStats)
 {
-    if (!IPythonScriptPlugin::Get()->IsPythonAvailable())
+    UE::FUsdStage Stage = UnrealUSDWrapper::NewStage();
+    if (!Stage)
     {
-        return false;
+        UE_LOG(LogMythicaEditor, Error, TEXT("Failed to create mesh export stage"));
+        return UE::FUsdStage();
+    }
+
+    UsdUtils::SetUsdStageMetersPerUnit(Stage, 1.0f);
+    UsdUtils::SetUsdStageUpAxis(Stage, pxr::TfToken("Y"));
+
+    int64 StrippedBytes = 0;
+    bool Success = false;
+    {
+        FScopedUsdAllocs UsdAllocs;
+
+        FMythicaMeshExportOptions GeometryOptions = Options;
+        GeometryOptions.Profile = EMythicaExportProfile::GeometryOnly;
+
+        pxr::UsdStageRefPtr UsdStage(Stage);
+        pxr::SdfPath MeshPath("/Mesh");
+        Success = AuthorExportMesh(UsdStage, MeshPath, Mesh, GeometryOptions, StrippedBytes, OutSimplifyTasks);
+        UsdStage->SetDefaultPrim(UsdStage->GetPrimAtPath(MeshPath));
+    }
+
+    if (!Success)
+    {
+        return UE::FUsdStage();
     }
 
-    FString Command;
-    Command.Append(TEXT("from mythica import usd_util\n"));
-    Command.Appendf(TEXT("usd_util.create_offset_scene('%s', '%s', (%f, %f, %f))\n"), *InFile, *OutFile, Offset.X, Offset.Y, Offset.Z);
+    if (OutStats)
+    {
+        OutStats->StrippedBytes += StrippedBytes;
+    }
 
-    IPythonScriptPlugin::Get()->ExecPythonCommand(*Command);
-    return true;
+    return Stage;
 }
 
-bool Mythica::ExportMesh(UStaticMesh* Mesh, const FString& ExportPath)
+static bool ExportMeshUncached(UStaticMesh* Mesh, const FString& ExportPath, const FMythicaMeshExportOptions& Options, FMythicaExportWriter& OutWriter, FMythicaExportStats* OutStats)
 {
+    // Geometry only, compact and simplified exports author the mesh directly, the asset exporter always writes materials
+    if (Options.Profile == EMythicaExportProfile::GeometryOnly || Options.Format == EMythicaExportFormat::CompactMesh || NeedsSimplification(Mesh, Options))
+    {
+        TArray<FMythicaMeshSimplifyTask> SimplifyTasks;
+        UE::FUsdStage Stage = AuthorMeshGeometry(Mesh, Options, SimplifyTasks, OutStats);
+        if (!Stage)
+        {
+            return false;
+        }
+
+        OutWriter = MakeStageWriter(MoveTemp(Stage), MoveTemp(SimplifyTasks), Options.Format);
+        return true;
+    }
+
+    // The asset exporter only writes to disk, its files are packaged next to ExportPath and read back
     FString TempFolder = FPaths::Combine(FPaths::GetPath(ExportPath), "USDExport");
     FString USDPath = FPaths::Combine(TempFolder, "Export.usd");
 
     UStaticMeshExporterUSDOptions* StaticMeshOptions = NewObject<UStaticMeshExporterUSDOptions>();
     StaticMeshOptions->StageOptions.MetersPerUnit = 1.0f;
     StaticMeshOptions->StageOptions.UpAxis = EUsdUpAxis::YAxis;
+    StaticMeshOptions->MeshAssetOptions.LowestMeshLOD = GetExportLOD(Mesh, Options);
+    StaticMeshOptions->MeshAssetOptions.HighestMeshLOD = GetExportLOD(Mesh, Options);
 
     UAssetExportTask* ExportTask = NewObject<UAssetExportTask>();
     FGCObjectScopeGuard ExportTaskGuard(ExportTask);
@@ -83,17 +1180,160 @@ bool Mythica::ExportMesh(UStaticMesh* Mesh, const FString& ExportPath)
 
     if (!UExporter::RunAssetExportTask(ExportTask))
     {
+        UE_LOG(LogMythicaEditor, Error, TEXT("Failed to export mesh to %s"), *USDPath);
         return false;
     }
 
-    return ConvertUSDtoUSDZ(USDPath, ExportPath);
+    OutWriter = [USDPath, ExportPath](TArray64<uint8>& OutData)
+    {
+        return ConvertUSDtoUSDZ(USDPath, ExportPath) && FFileHelper::LoadFileToArray(OutData, *ExportPath);
+    };
+    return true;
 }
 
-bool Mythica::ExportActors(const TArray<AActor*> Actors, const FString& ExportPath, const FVector& Origin, EMythicaExportTransformType TransformType)
+bool Mythica::ExportMesh(UStaticMesh* Mesh, const FString& ExportPath, const FMythicaMeshExportOptions& Options, FMythicaExportWriter& OutWriter, FMythicaExportStats* OutStats)
 {
-    FString TempFolder = FPaths::Combine(FPaths::GetPath(ExportPath), "USDExport");
-    FString USDPath = FPaths::Combine(TempFolder, "Export.usd");
+    if (!GetDefault<UMythicaDeveloperSettings>()->EnableExportLayerCache)
+    {
+        return ExportMeshUncached(Mesh, ExportPath, Options, OutWriter, OutStats);
+    }
+
+    // Unchanged meshes are read from the cache without running the exporter
+    FString CachePath = GetExportCachePath(Mesh, Options, Mythica::GetExportExtension(Options.Format));
+    if (FindCachedExport(CachePath))
+    {
+        OutWriter = [CachePath](TArray64<uint8>& OutData)
+        {
+            return FFileHelper::LoadFileToArray(OutData, *CachePath);
+        };
+        return true;
+    }
+
+    FMythicaExportWriter ExportWriter;
+    if (!ExportMeshUncached(Mesh, ExportPath, Options, ExportWriter, OutStats))
+    {
+        return false;
+    }
+
+    FString MeshName = Mesh->GetName();
+    OutWriter = [ExportWriter = MoveTemp(ExportWriter), CachePath, MeshName](TArray64<uint8>& OutData) mutable
+    {
+        if (!ExportWriter(OutData))
+        {
+            return false;
+        }
+
+        FString TempPath = MakeExportCacheTempPath(CachePath);
+        if (!FFileHelper::SaveArrayToFile(OutData, *TempPath) || !IFileManager::Get().Move(*CachePath, *TempPath))
+        {
+            UE_LOG(LogMythicaEditor, Warning, TEXT("Failed to cache export of mesh %s"), *MeshName);
+            IFileManager::Get().Delete(*TempPath, false, true, true);
+        }
+
+        return true;
+    };
+    return true;
+}
+
+const TCHAR* Mythica::GetExportExtension(EMythicaExportFormat Format)
+{
+    return Format == EMythicaExportFormat::CompactMesh ? Mythica::CompactMeshExtension : TEXT("usdz");
+}
 
+bool Mythica::BenchmarkCompactMesh(UStaticMesh* Mesh)
+{
+    // Both encodings carry the geometry of the same stage, decoding USDZ means opening it and reading the meshes back
+    FMythicaMeshExportOptions Options;
+    Options.Profile = EMythicaExportProfile::GeometryOnly;
+
+    TArray<FMythicaMeshSimplifyTask> SimplifyTasks;
+    UE::FUsdStage Stage = AuthorMeshGeometry(Mesh, Options, SimplifyTasks, nullptr);
+    if (!Stage)
+    {
+        return false;
+    }
+
+    double StartTime = FPlatformTime::Seconds();
+    TArray64<uint8> UsdzData;
+    if (!PackageStage(Stage, UsdzData))
+    {
+        return false;
+    }
+    double UsdzEncodeSeconds = FPlatformTime::Seconds() - StartTime;
+
+    FString UsdzPath = FPaths::ConvertRelativePathToFull(FPaths::Combine(FPaths::ProjectIntermediateDir(), TEXT("MythicaCache"), TEXT("Benchmark"), FGuid::NewGuid().ToString() + TEXT(".usdz")));
+    if (!FFileHelper::SaveArrayToFile(UsdzData, *UsdzPath))
+    {
+        UE_LOG(LogMythicaEditor, Error, TEXT("Failed to write %s"), *UsdzPath);
+        return false;
+    }
+
+    FMythicaCompactMeshData SourceMesh;
+    double UsdzDecodeSeconds = 0.0;
+    {
+        FScopedUsdAllocs UsdAllocs;
+
+        StartTime = FPlatformTime::Seconds();
+        pxr::UsdStageRefPtr UsdzStage = pxr::UsdStage::Open(TCHAR_TO_UTF8(*UsdzPath));
+        if (UsdzStage)
+        {
+            FlattenStage(UsdzStage, SourceMesh);
+        }
+        UsdzDecodeSeconds = FPlatformTime::Seconds() - StartTime;
+    }
+    IFileManager::Get().Delete(*UsdzPath, false, true, true);
+
+    if (SourceMesh.Indices.IsEmpty())
+    {
+        UE_LOG(LogMythicaEditor, Error, TEXT("Failed to read back USDZ export of %s"), *Mesh->GetName());
+        return false;
+    }
+
+    StartTime = FPlatformTime::Seconds();
+    TArray64<uint8> CompactData;
+    if (!Mythica::EncodeCompactMesh(SourceMesh, CompactData))
+    {
+        return false;
+    }
+    double CompactEncodeSeconds = FPlatformTime::Seconds() - StartTime;
+
+    StartTime = FPlatformTime::Seconds();
+    FMythicaCompactMeshData DecodedMesh;
+    if (!Mythica::DecodeCompactMesh(CompactData, DecodedMesh))
+    {
+        return false;
+    }
+    double CompactDecodeSeconds = FPlatformTime::Seconds() - StartTime;
+
+    // Uploads are gzip compressed, so the sizes after compression are what goes over the wire
+    int32 Level = GetDefault<UMythicaDeveloperSettings>()->UploadCompressionLevel;
+    TArray64<uint8> UsdzCompressed;
+    TArray64<uint8> CompactCompressed;
+    Mythica::GzipData(UsdzData, Level, UsdzCompressed);
+    Mythica::GzipData(CompactData, Level, CompactCompressed);
+
+    FMythicaCompactMeshError Error = Mythica::MeasureCompactMeshError(SourceMesh, DecodedMesh);
+
+    UE_LOG(LogMythicaEditor, Display, TEXT("%s: %d vertices, %d triangles"), *Mesh->GetName(), SourceMesh.Positions.Num(), SourceMesh.Indices.Num() / 3);
+    UE_LOG(LogMythicaEditor, Display, TEXT("  USDZ     %10lld bytes, %10lld gzip, encode %8.2f ms, decode %8.2f ms"),
+        UsdzData.Num(), UsdzCompressed.Num(), UsdzEncodeSeconds * 1000.0, UsdzDecodeSeconds * 1000.0);
+    UE_LOG(LogMythicaEditor, Display, TEXT("  Compact  %10lld bytes, %10lld gzip, encode %8.2f ms, decode %8.2f ms"),
+        CompactData.Num(), CompactCompressed.Num(), CompactEncodeSeconds * 1000.0, CompactDecodeSeconds * 1000.0);
+
+    if (!Error.IsWithinTolerance())
+    {
+        UE_LOG(LogMythicaEditor, Error, TEXT("  Round trip out of tolerance: topology %s, position %g (tolerance %g), normal %g deg, uv %g (tolerance %g)"),
+            Error.TopologyMatches ? TEXT("matches") : TEXT("differs"), Error.MaxPositionError, Error.PositionTolerance, Error.MaxNormalErrorDegrees, Error.MaxUVError, Error.UVTolerance);
+        return false;
+    }
+
+    UE_LOG(LogMythicaEditor, Display, TEXT("  Round trip error: position %g (tolerance %g), normal %g deg, uv %g (tolerance %g)"),
+        Error.MaxPositionError, Error.PositionTolerance, Error.MaxNormalErrorDegrees, Error.MaxUVError, Error.UVTolerance);
+    return true;
+}
+
+bool Mythica::ExportActors(const TArray<AActor*> Actors, const FVector& Origin, EMythicaExportTransformType TransformType, const FMythicaMeshExportOptions& Options, FMythicaExportWriter& OutWriter, FMythicaExportStats* OutStats)
+{
     // Determine export origin
     FVector ExportOrigin = FVector::ZeroVector;
 
@@ -118,70 +1358,53 @@ bool Mythica::ExportActors(const TArray<AActor*> Actors, const FString& ExportPa
             break;
     }
 
-    // Save original selection
-    TArray<AActor*> OriginalSelection;
-    TArray<UActorComponent*> OriginalComponentSelection;
-    GEditor->GetSelectedActors()->GetSelectedObjects<AActor>(OriginalSelection);
-    GEditor->GetSelectedComponents()->GetSelectedObjects<UActorComponent>(OriginalComponentSelection);
-
-    // Set selection to target actors
-    GEditor->SelectNone(false, false, false);
-    for (AActor* Actor : Actors)
+    // Author the static mesh components straight into a new stage, this doesn't touch the editor selection
+    UE::FUsdStage Stage = UnrealUSDWrapper::NewStage();
+    if (!Stage)
     {
-        GEditor->SelectActor(Actor, true, false, true);
+        UE_LOG(LogMythicaEditor, Error, TEXT("Failed to create actor export stage"));
+        return false;
     }
 
-    // Export selected actors
-    ULevelExporterUSDOptions* LevelOptions = GetMutableDefault<ULevelExporterUSDOptions>();
-    LevelOptions->StageOptions.MetersPerUnit = 1.0f;
-    LevelOptions->StageOptions.UpAxis = EUsdUpAxis::YAxis;
+    UsdUtils::SetUsdStageMetersPerUnit(Stage, 1.0f);
+    UsdUtils::SetUsdStageUpAxis(Stage, pxr::TfToken("Y"));
 
-    UAssetExportTask* ExportTask = NewObject<UAssetExportTask>();
-    FGCObjectScopeGuard ExportTaskGuard(ExportTask);
-    ExportTask->Object = GWorld;
-    ExportTask->Options = LevelOptions;
-    ExportTask->Exporter = nullptr;
-    ExportTask->Filename = USDPath;
-    ExportTask->bSelected = true;
-    ExportTask->bReplaceIdentical = true;
-    ExportTask->bPrompt = false;
-    ExportTask->bUseFileArchive = false;
-    ExportTask->bWriteEmptyFiles = false;
-    ExportTask->bAutomated = true;
+    TArray<FMythicaMeshSimplifyTask> SimplifyTasks;
+    {
+        FScopedUsdAllocs UsdAllocs;
 
-    bool PrevSilent = GIsSilent;
-    GIsSilent = true;
-    bool Success = UExporter::RunAssetExportTask(ExportTask);
-    GIsSilent = PrevSilent;
+        FMythicaActorExportContext Context{ pxr::UsdStageRefPtr(Stage), FUsdStageInfo(Stage), ExportOrigin, Options };
+        Context.UseLayerCache = GetDefault<UMythicaDeveloperSettings>()->EnableExportLayerCache;
 
-    // Restore original selection
-    GEditor->SelectNone(false, false, false);
-    for (AActor* Actor : OriginalSelection)
-    {
-        GEditor->SelectActor(Actor, true, false, true);
-    }
-    for (UActorComponent* Component : OriginalComponentSelection)
-    {
-        GEditor->SelectComponent(Component, true, false, true);
-    }
-    GEditor->NoteSelectionChange();
+        pxr::SdfPath RootPath("/Root");
+        pxr::UsdPrim RootPrim = pxr::UsdGeomXform::Define(Context.Stage, RootPath).GetPrim();
+        Context.Stage->SetDefaultPrim(RootPrim);
 
-    // Modify scene to be relative to the desired origin
-    FString OffsetUSDPath = FPaths::Combine(TempFolder, "Export_Offset.usd");
-    FVector USDOrigin(ExportOrigin.X / 100.0f, ExportOrigin.Z / 100.0f, ExportOrigin.Y / 100.0f);
-    if (!CreateOffsetScene(USDPath, OffsetUSDPath, -USDOrigin))
-    {
-        return false;
+        TSet<FString> UsedNames;
+        for (const AActor* Actor : Actors)
+        {
+            pxr::SdfPath ActorPath = MakeUniqueChildPath(RootPath, Actor->GetActorNameOrLabel(), UsedNames);
+            if (!ExportActor(Context, Actor, ActorPath))
+            {
+                UE_LOG(LogMythicaEditor, Error, TEXT("Failed to export actor %s"), *Actor->GetActorNameOrLabel());
+                return false;
+            }
+        }
+
+        if (OutStats)
+        {
+            OutStats->StrippedBytes += Context.StrippedBytes;
+        }
+
+        SimplifyTasks = MoveTemp(Context.SimplifyTasks);
     }
 
-    return Success ? ConvertUSDtoUSDZ(OffsetUSDPath, ExportPath) : false;
+    OutWriter = MakeStageWriter(MoveTemp(Stage), MoveTemp(SimplifyTasks), Options.Format);
+    return true;
 }
 
-bool Mythica::ExportSpline(AActor* SplineActor, const FString& ExportPath, const FVector& Origin, EMythicaExportTransformType TransformType)
+bool Mythica::ExportSpline(AActor* SplineActor, const FVector& Origin, EMythicaExportTransformType TransformType, FMythicaExportWriter& OutWriter)
 {
-    FString TempFolder = FPaths::Combine(FPaths::GetPath(ExportPath), "USDExport");
-    FString USDPath = FPaths::Combine(TempFolder, "Export.usd");
-
     USplineComponent* SplineComponent = SplineActor->FindComponentByClass<USplineComponent>();
     if (!SplineComponent)
     {
@@ -224,7 +1447,7 @@ bool Mythica::ExportSpline(AActor* SplineActor, const FString& ExportPath, const
     }
 
     // Create curve primitive
-    UE::FUsdStage Stage = UnrealUSDWrapper::NewStage(*USDPath);
+    UE::FUsdStage Stage = UnrealUSDWrapper::NewStage();
     if (!Stage)
     {
         return false;
@@ -241,9 +1464,8 @@ bool Mythica::ExportSpline(AActor* SplineActor, const FString& ExportPath, const
     Curves.CreateTypeAttr().Set(pxr::TfToken("linear"));
     Curves.CreateWrapAttr().Set(pxr::TfToken("nonperiodic"));
 
-    Stage.GetRootLayer().Save();
-
-    return ConvertUSDtoUSDZ(USDPath, ExportPath);
+    OutWriter = MakeStageWriter(MoveTemp(Stage));
+    return true;
 }
 
 static void GatherPrimsToImportRecursive(const UE::FUsdPrim& Prim, TArray<FString>& PrimsToImport)
@@ -279,8 +1501,126 @@ static bool GatherPrimsToImport(const FString& FilePath, TArray<FString>& PrimsT
     return true;
 }
 
-bool Mythica::ImportMesh(const FString& FilePath, const FString& ImportDirectory)
+static void RepairLevelReferences(const TMap<UObject*, UObject*>& AssetReplacementMap)
+{
+    // Repair references to the original asset in the active level
+    ULevel* CurrentLevel = GWorld->GetCurrentLevel();
+    if (CurrentLevel)
+    {
+        constexpr EArchiveReplaceObjectFlags
+            ReplaceFlags = (EArchiveReplaceObjectFlags::IgnoreOuterRef | EArchiveReplaceObjectFlags::IgnoreArchetypeRef | EArchiveReplaceObjectFlags::TrackReplacedReferences);
+        FArchiveReplaceObjectRef<UObject> ArchiveReplaceObjectRefInner(CurrentLevel, AssetReplacementMap, ReplaceFlags);
+
+        // Update render state of repaired references
+        for (const TPair<UObject*, TArray<FProperty*>>& Reference : ArchiveReplaceObjectRefInner.GetReplacedReferences())
+        {
+            UActorComponent* UpdatedComponent = Cast<UActorComponent>(Reference.Key);
+            if (UpdatedComponent)
+            {
+                UpdatedComponent->MarkRenderStateDirty();
+            }
+        }
+    }
+}
+
+/** Decodes a compact mesh file into a USD layer with the same name next to it, other files are imported as they are */
+static bool DecodeCompactMeshFile(const FString& FilePath, FString& OutImportPath)
+{
+    OutImportPath = FilePath;
+
+    TArray64<uint8> Data;
+    if (!FFileHelper::LoadFileToArray(Data, *FilePath) || !Mythica::IsCompactMesh(Data.GetData(), Data.Num()))
+    {
+        return true;
+    }
+
+    FMythicaCompactMeshData Mesh;
+    if (!Mythica::DecodeCompactMesh(Data, Mesh))
+    {
+        return false;
+    }
+
+    OutImportPath = FPaths::Combine(FPaths::GetPath(FilePath), FPaths::GetBaseFilename(FilePath) + TEXT(".usdc"));
+    UE::FUsdStage Stage = UnrealUSDWrapper::NewStage(*OutImportPath);
+    if (!Stage)
+    {
+        UE_LOG(LogMythicaEditor, Error, TEXT("Failed to create %s"), *OutImportPath);
+        return false;
+    }
+
+    UsdUtils::SetUsdStageMetersPerUnit(Stage, 1.0f);
+    UsdUtils::SetUsdStageUpAxis(Stage, pxr::TfToken("Y"));
+
+    {
+        FScopedUsdAllocs UsdAllocs;
+
+        pxr::UsdStageRefPtr UsdStage(Stage);
+        pxr::UsdGeomMesh UsdMesh = pxr::UsdGeomMesh::Define(UsdStage, pxr::SdfPath("/Mesh"));
+        UsdStage->SetDefaultPrim(UsdMesh.GetPrim());
+
+        pxr::VtArray<pxr::GfVec3f> Points;
+        Points.reserve(Mesh.Positions.Num());
+        for (const FVector3f& Position : Mesh.Positions)
+        {
+            Points.push_back(pxr::GfVec3f(Position.X, Position.Y, Position.Z));
+        }
+
+        pxr::VtArray<int> FaceVertexIndices(Mesh.Indices.begin(), Mesh.Indices.end());
+        pxr::VtArray<int> FaceVertexCounts(Mesh.Indices.Num() / 3, 3);
+
+        pxr::VtArray<pxr::GfVec3f> Extent(2);
+        pxr::UsdGeomPointBased::ComputeExtent(Points, &Extent);
+
+        UsdMesh.CreateSubdivisionSchemeAttr().Set(pxr::UsdGeomTokens->none);
+        UsdMesh.CreatePointsAttr().Set(Points);
+        UsdMesh.CreateExtentAttr().Set(Extent);
+        UsdMesh.CreateFaceVertexCountsAttr().Set(FaceVertexCounts);
+        UsdMesh.CreateFaceVertexIndicesAttr().Set(FaceVertexIndices);
+
+        if (!Mesh.Normals.IsEmpty())
+        {
+            pxr::VtArray<pxr::GfVec3f> Normals;
+            Normals.reserve(Mesh.Normals.Num());
+            for (const FVector3f& Normal : Mesh.Normals)
+            {
+                Normals.push_back(pxr::GfVec3f(Normal.X, Normal.Y, Normal.Z));
+            }
+
+            UsdMesh.CreateNormalsAttr().Set(Normals);
+            UsdMesh.SetNormalsInterpolation(pxr::UsdGeomTokens->vertex);
+        }
+
+        if (!Mesh.UVs.IsEmpty())
+        {
+            pxr::VtArray<pxr::GfVec2f> UVs;
+            UVs.reserve(Mesh.UVs.Num());
+            for (const FVector2f& UV : Mesh.UVs)
+            {
+                UVs.push_back(pxr::GfVec2f(UV.X, UV.Y));
+            }
+
+            pxr::UsdGeomPrimvar UVPrimvar = pxr::UsdGeomPrimvarsAPI(UsdMesh.GetPrim()).CreatePrimvar(pxr::TfToken("st"), pxr::SdfValueTypeNames->TexCoord2fArray, pxr::UsdGeomTokens->vertex);
+            UVPrimvar.Set(UVs);
+        }
+    }
+
+    if (!Stage.GetRootLayer().Save())
+    {
+        UE_LOG(LogMythicaEditor, Error, TEXT("Failed to write decoded compact mesh %s"), *OutImportPath);
+        return false;
+    }
+
+    return true;
+}
+
+bool Mythica::ImportMesh(const FString& InFilePath, const FString& ImportDirectory)
 {
+    FString FilePath;
+    if (!DecodeCompactMeshFile(InFilePath, FilePath))
+    {
+        return false;
+    }
+
     // Select subset of scene to import
     TArray<FString> PrimsToImport;
     if (!GatherPrimsToImport(FilePath, PrimsToImport) || PrimsToImport.IsEmpty())
@@ -383,24 +1723,65 @@ bool Mythica::ImportMesh(const FString& FilePath, const FString& ImportDirectory
         }
     }
 
-    // Repair references to the original asset in the active level
-    ULevel* CurrentLevel = GWorld->GetCurrentLevel();
-    if (CurrentLevel)
+    RepairLevelReferences(AssetReplacementMap);
+
+    return Task->GetObjects().Num() > 0;
+}
+
+bool Mythica::DuplicateImport(const FString& SourceDirectory, const FString& TargetDirectory)
+{
+    FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
+
+    TArray<FAssetData> SourceAssets;
+    AssetRegistryModule.Get().GetAssetsByPath(*SourceDirectory, SourceAssets, true, false);
+    if (SourceAssets.IsEmpty())
     {
-        constexpr EArchiveReplaceObjectFlags
-            ReplaceFlags = (EArchiveReplaceObjectFlags::IgnoreOuterRef | EArchiveReplaceObjectFlags::IgnoreArchetypeRef | EArchiveReplaceObjectFlags::TrackReplacedReferences);
-        FArchiveReplaceObjectRef<UObject> ArchiveReplaceObjectRefInner(CurrentLevel, AssetReplacementMap, ReplaceFlags);
+        return false;
+    }
 
-        // Update render state of repaired references
-        for (const TPair<UObject*, TArray<FProperty*>>& Reference : ArchiveReplaceObjectRefInner.GetReplacedReferences())
+    TMap<UObject*, UObject*> SourceToDuplicateMap;
+    TMap<UObject*, UObject*> AssetReplacementMap;
+
+    for (const FAssetData& Asset : SourceAssets)
+    {
+        UObject* SourceObject = Asset.GetAsset();
+        if (!SourceObject)
         {
-            UActorComponent* UpdatedComponent = Cast<UActorComponent>(Reference.Key);
-            if (UpdatedComponent)
-            {
-                UpdatedComponent->MarkRenderStateDirty();
-            }
+            continue;
+        }
+
+        FString RelativePackageName = Asset.PackageName.ToString().RightChop(SourceDirectory.Len());
+        UPackage* TargetPackage = CreatePackage(*(TargetDirectory + RelativePackageName));
+
+        // Move any previous asset out of the way, references to it are repaired below
+        UObject* ExistingObject = StaticFindObject(UObject::StaticClass(), TargetPackage, *SourceObject->GetName());
+        if (ExistingObject)
+        {
+            ExistingObject->Rename(nullptr, GetTransientPackage(), REN_DontCreateRedirectors | REN_NonTransactional);
+        }
+
+        UObject* DuplicateObject = StaticDuplicateObject(SourceObject, TargetPackage, SourceObject->GetFName());
+        DuplicateObject->SetFlags(RF_Public | RF_Standalone);
+        DuplicateObject->MarkPackageDirty();
+        FAssetRegistryModule::AssetCreated(DuplicateObject);
+
+        SourceToDuplicateMap.Add(SourceObject, DuplicateObject);
+        if (ExistingObject)
+        {
+            AssetReplacementMap.Add(ExistingObject, DuplicateObject);
         }
     }
 
-    return Task->GetObjects().Num() > 0;
+    // Point duplicated assets at each other instead of the source import, e.g. meshes at their materials
+    for (const TPair<UObject*, UObject*>& Pair : SourceToDuplicateMap)
+    {
+        constexpr EArchiveReplaceObjectFlags ReplaceFlags = (EArchiveReplaceObjectFlags::IgnoreOuterRef | EArchiveReplaceObjectFlags::IgnoreArchetypeRef);
+        FArchiveReplaceObjectRef<UObject> ReplaceObjectRef(Pair.Value, SourceToDuplicateMap, ReplaceFlags);
+
+        Pair.Value->PostEditChange();
+    }
+
+    RepairLevelReferences(AssetReplacementMap);
+
+    return !SourceToDuplicateMap.IsEmpty();
 }
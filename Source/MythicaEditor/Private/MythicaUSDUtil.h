@@ -14,11 +14,59 @@ enum class EMythicaExportTransformType : uint8
     Centered
 };
 
+UENUM(BlueprintType)
+enum class EMythicaExportProfile : uint8
+{
+    Full,
+    GeometryOnly    UMETA(ToolTip = "Only export geometry, without materials and UV sets other than the first")
+};
+
+UENUM(BlueprintType)
+enum class EMythicaExportFormat : uint8
+{
+    Usdz,
+    CompactMesh     UMETA(ToolTip = "Merge the input into a single triangle mesh with quantized positions, normals and UVs. Much smaller to upload, but without materials and instancing.")
+};
+
+struct FMythicaMeshExportOptions
+{
+    EMythicaExportProfile Profile = EMythicaExportProfile::Full;
+    EMythicaExportFormat Format = EMythicaExportFormat::Usdz;
+
+    /** Level of detail exported for static meshes, clamped to each mesh's lowest LOD */
+    int32 LOD = 0;
+
+    /** Meshes with more triangles are simplified down to this many when the input is written, 0 keeps them as they are */
+    int32 TriangleBudget = 0;
+};
+
+struct FMythicaExportStats
+{
+    /** Estimated size of the data left out by the export profile */
+    int64 StrippedBytes = 0;
+};
+
+/** Packages an input authored by one of the export functions into a USDZ or compact mesh in memory, safe to run on any thread */
+using FMythicaExportWriter = TUniqueFunction<bool(TArray64<uint8>& OutData)>;
+
 namespace Mythica
 {
-    bool ExportMesh(UStaticMesh* Mesh, const FString& ExportPath);
-    bool ExportActors(const TArray<AActor*> Actors, const FString& ExportPath, const FVector& Origin, EMythicaExportTransformType TransformType);
-    bool ExportSpline(AActor* SplineActor, const FString& ExportPath, const FVector& Origin, EMythicaExportTransformType TransformType);
+    // Exports read the engine data and author the input on the game thread, the writer they return packages it.
+    // Only the static mesh asset exporter needs files, it writes them next to ExportPath.
+    bool ExportMesh(UStaticMesh* Mesh, const FString& ExportPath, const FMythicaMeshExportOptions& Options, FMythicaExportWriter& OutWriter, FMythicaExportStats* OutStats = nullptr);
+    bool ExportActors(const TArray<AActor*> Actors, const FVector& Origin, EMythicaExportTransformType TransformType, const FMythicaMeshExportOptions& Options, FMythicaExportWriter& OutWriter, FMythicaExportStats* OutStats = nullptr);
+    bool ExportSpline(AActor* SplineActor, const FVector& Origin, EMythicaExportTransformType TransformType, FMythicaExportWriter& OutWriter);
+
+    /** Removes cached mesh exports that weren't used for longer than the expiry */
+    void TrimExportLayerCache(double ExpirySeconds);
+
+    /** Extension of the files written in the export format */
+    const TCHAR* GetExportExtension(EMythicaExportFormat Format);
+
+    /** Compares the compact encoding of a mesh with its USDZ export and checks its round trip error, returns false if it is out of tolerance */
+    bool BenchmarkCompactMesh(UStaticMesh* Mesh);
 
+    // Compact mesh files are detected by their header and decoded before they are imported
     bool ImportMesh(const FString& FilePath, const FString& ImportDirectory);
+    bool DuplicateImport(const FString& SourceDirectory, const FString& TargetDirectory);
 }
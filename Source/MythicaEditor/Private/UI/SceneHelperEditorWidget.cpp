@@ -4,6 +4,7 @@
 #include "UI/SceneHelperEditorWidget.h"
 
 #include "EditorUtilityWidgetComponents.h"
+#include "Jobs/MythicaJobSubsystem.h"
 #include "Kismet\KismetSystemLibrary.h"
 #include "MythicaComponent.h"
 #include "MythicaEditorSubsystem.h"
@@ -34,7 +35,7 @@ void USceneHelperEditorWidget::NativeConstruct()
         {
             Stats.FinishedJobsCount++;
         }
-        else if (Job.State >= EMythicaJobState::Requesting)
+        else if (Job.State >= EMythicaJobState::Scheduled)
         {
             Stats.ActiveJobsCount++;
         }
@@ -210,6 +211,10 @@ void USceneHelperEditorWidget::NativePoll()
     // Updating our stats
     Stats.ActorCount = MythicaActors.Num();
     Stats.ComponentCount = TrackedComponentWidgets.Num();
+
+    UMythicaJobSubsystem* JobSubsystem = GEngine->GetEngineSubsystem<UMythicaJobSubsystem>();
+    Stats.QueuedJobsCount = JobSubsystem->GetNumQueuedJobs();
+    Stats.JobQueueSaturated = JobSubsystem->IsSaturated();
 }
 
 USceneHelperEntryEditorWidget* USceneHelperEditorWidget::CreateSceneEntry(UMythicaComponent* OwningComponent)
@@ -26,6 +26,14 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Jobs")
     int32 FinishedJobsCount = 0;
 
+    /** Jobs waiting for a free job slot */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Jobs")
+    int32 QueuedJobsCount = 0;
+
+    /** The job queue is longer than the back-pressure threshold */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Jobs")
+    bool JobQueueSaturated = false;
+
 };
 
 class UEditorUtilityScrollBox;
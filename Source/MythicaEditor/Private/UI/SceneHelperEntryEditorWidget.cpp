@@ -73,7 +73,7 @@ void USceneHelperEntryEditorWidget::NativeJobCreated(int RequestId)
 
 void USceneHelperEntryEditorWidget::NativeJobStateUpdated(int RequestId, EMythicaJobState State, FText Message)
 {
-    if (State == EMythicaJobState::Completed || State == EMythicaJobState::Failed)
+    if (State >= EMythicaJobState::Completed)
     {
         CacheCurrentJobData();
     }
@@ -0,0 +1,452 @@
+#!/usr/bin/env python3
+"""
+Local stand-in for the Mythica service used by the MythicaGenerate commandlet.
+
+Implements the subset of the API the plugin uses to run jobs: sessions, uploads,
+resumable upload sessions, job submission, result polling, downloads and cancellation. Jobs complete after a
+configurable latency and return either a fixed result file or the first uploaded
+input, so maps can be rebaked headless without access to the real service.
+
+    python3 stand_in_service.py --port 8080 --latency 0.5 --result-file Mesh.usdz
+"""
+
+import argparse
+import gzip
+import json
+import random
+import re
+import struct
+import threading
+import time
+import uuid
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+
+
+class StandInState:
+    def __init__(self, latency, result_file, accept_gzip, fail_rate):
+        self.latency = latency
+        self.accept_gzip = accept_gzip
+        self.fail_rate = fail_rate
+        self.result_data = None
+        if result_file:
+            with open(result_file, "rb") as f:
+                self.result_data = f.read()
+
+        self.lock = threading.Lock()
+        self.files = {}
+        self.jobs = {}
+        self.upload_sessions = {}
+        self.stats = {
+            "uploads": 0, "uploaded_bytes": 0, "compressed_files": 0, "decoded_bytes": 0,
+            "upload_sessions": 0, "upload_parts": 0, "injected_faults": 0, "jobs": 0, "canceled": 0,
+            "compact_meshes": 0,
+        }
+
+    def add_file(self, data):
+        file_id = "file_" + uuid.uuid4().hex
+        with self.lock:
+            self.files[file_id] = data
+        return file_id
+
+    def get_file(self, file_id):
+        with self.lock:
+            return self.files.get(file_id)
+
+
+COMPACT_MESH_MAGIC = b"MYCM"
+COMPACT_MESH_VERSION = 1
+COMPACT_MESH_HAS_NORMALS = 1 << 0
+COMPACT_MESH_HAS_UVS = 1 << 1
+
+
+def is_compact_mesh(file_name, data):
+    return file_name.lower().endswith(".mcm") or data.startswith(COMPACT_MESH_MAGIC)
+
+
+def validate_compact_mesh(data):
+    """Checks the layout of a compact mesh written by the plugin, returns a description of the problem or None"""
+    header = struct.Struct("<4sHHII3f3f")
+    if len(data) < header.size:
+        return "truncated header"
+
+    magic, version, flags, num_vertices, num_indices, *_ = header.unpack_from(data)
+    if magic != COMPACT_MESH_MAGIC:
+        return "missing compact mesh header"
+    if version != COMPACT_MESH_VERSION:
+        return f"unsupported version {version}"
+    if num_indices % 3 != 0:
+        return f"{num_indices} indices don't form triangles"
+
+    offset = header.size
+    if flags & COMPACT_MESH_HAS_UVS:
+        offset += 16
+
+    components = 3 + (2 if flags & COMPACT_MESH_HAS_NORMALS else 0) + (2 if flags & COMPACT_MESH_HAS_UVS else 0)
+    offset += num_vertices * components * 2
+    if offset + num_indices > len(data):
+        return "truncated vertex data"
+
+    previous = 0
+    for i in range(num_indices):
+        value = 0
+        shift = 0
+        while True:
+            if offset >= len(data) or shift >= 64:
+                return "truncated indices"
+            byte = data[offset]
+            offset += 1
+            value |= (byte & 0x7F) << shift
+            shift += 7
+            if not byte & 0x80:
+                break
+
+        index = previous + ((value >> 1) ^ -(value & 1))
+        if index < 0 or index >= num_vertices:
+            return f"index {index} out of range at {i}"
+        previous = index
+
+    return None
+
+
+def parse_multipart(content_type, body):
+    """Returns the (filename, content encoding, data) tuples of a multipart/form-data body"""
+    match = re.search(r"boundary\s*=\s*\"?([^\";]+)\"?", content_type)
+    if not match:
+        return []
+
+    delimiter = b"--" + match.group(1).strip().encode()
+    parts = []
+    for part in body.split(delimiter)[1:]:
+        if part.startswith(b"--"):
+            break
+
+        header_end = part.find(b"\r\n\r\n")
+        if header_end < 0:
+            continue
+
+        headers = part[:header_end].decode(errors="replace")
+        data = part[header_end + 4:]
+        if data.endswith(b"\r\n"):
+            data = data[:-2]
+
+        name = re.search(r"filename=\"([^\"]*)\"", headers)
+        encoding = re.search(r"^Content-Encoding:\s*(\S+)", headers, re.IGNORECASE | re.MULTILINE)
+        parts.append((name.group(1) if name else "", encoding.group(1).lower() if encoding else "", data))
+
+    return parts
+
+
+def find_input_file_ids(params):
+    file_ids = []
+    for value in params.values():
+        if isinstance(value, dict) and "file_id" in value:
+            file_ids.append(value["file_id"])
+        elif isinstance(value, list):
+            file_ids.extend(item["file_id"] for item in value if isinstance(item, dict) and "file_id" in item)
+    return file_ids
+
+
+class StandInHandler(BaseHTTPRequestHandler):
+    protocol_version = "HTTP/1.1"
+    state = None
+
+    def log_message(self, format, *args):
+        if self.server.verbose:
+            super().log_message(format, *args)
+
+    def send_json(self, value, status=200):
+        payload = json.dumps(value).encode()
+        self.send_response(status)
+        self.send_header("Content-Type", "application/json")
+        self.send_header("Content-Length", str(len(payload)))
+        self.end_headers()
+        self.wfile.write(payload)
+
+    def send_bytes(self, data):
+        self.send_response(200)
+        self.send_header("Content-Type", "application/octet-stream")
+        self.send_header("Content-Length", str(len(data)))
+        self.end_headers()
+        self.wfile.write(data)
+
+    def read_body(self):
+        length = int(self.headers.get("Content-Length", 0))
+        return self.rfile.read(length) if length > 0 else b""
+
+    def do_GET(self):
+        path = self.path.split("?")[0]
+
+        if path.startswith("/v1/upload/sessions/"):
+            self.get_upload_session(path.rsplit("/", 1)[-1])
+        elif path.startswith("/v1/sessions/key/"):
+            self.send_json({"token": "stand-in-" + uuid.uuid4().hex})
+        elif path.startswith("/v1/jobs/results/"):
+            self.get_job_results(path.rsplit("/", 1)[-1])
+        elif path.startswith("/v1/download/info/"):
+            file_id = path.rsplit("/", 1)[-1]
+            host = self.headers.get("Host", "localhost")
+            self.send_json({"url": f"http://{host}/files/{file_id}", "content_type": "application/octet-stream"})
+        elif path.startswith("/files/"):
+            data = self.state.get_file(path.rsplit("/", 1)[-1])
+            if data is None:
+                self.send_json({"detail": "file not found"}, 404)
+            else:
+                self.send_bytes(data)
+        elif path == "/stats":
+            with self.state.lock:
+                self.send_json(dict(self.state.stats))
+        elif path.startswith("/v1/jobs/definitions/") or path.startswith("/v1/assets/"):
+            # Components already carry their job definition, the catalog stays empty
+            self.send_json([])
+        else:
+            self.send_json({"detail": "not found"}, 404)
+
+    def do_PUT(self):
+        path = self.path.split("?")[0]
+
+        if path.startswith("/v1/upload/sessions/"):
+            self.put_upload_part(path.rsplit("/", 1)[-1])
+        else:
+            self.read_body()
+            self.send_json({"detail": "not found"}, 404)
+
+    def do_POST(self):
+        path = self.path.split("?")[0]
+        body = self.read_body()
+
+        if path == "/v1/upload/store":
+            self.upload_files(body)
+        elif path.rstrip("/") == "/v1/upload/sessions":
+            self.create_upload_session(body)
+        elif path.rstrip("/") == "/v1/jobs":
+            self.create_job(body)
+        elif path.startswith("/v1/jobs/") and path.endswith("/cancel"):
+            job_id = path.split("/")[3]
+            with self.state.lock:
+                job = self.state.jobs.get(job_id)
+                if job:
+                    job["canceled"] = True
+                    self.state.stats["canceled"] += 1
+            self.send_json({"job_id": job_id}, 200 if job else 404)
+        else:
+            self.send_json({"detail": "not found"}, 404)
+
+    def upload_files(self, body):
+        parts = parse_multipart(self.headers.get("Content-Type", ""), body)
+
+        decoded = []
+        compressed_files = 0
+        for file_name, encoding, data in parts:
+            if encoding == "gzip" and self.state.accept_gzip:
+                try:
+                    data = gzip.decompress(data)
+                except OSError:
+                    self.send_json({"detail": f"invalid gzip data in {file_name}"}, 400)
+                    return
+                compressed_files += 1
+            elif encoding and encoding != "identity":
+                self.send_json({"detail": f"unsupported content encoding {encoding}"}, 415)
+                return
+            decoded.append((file_name, data))
+
+        compact_meshes = 0
+        for file_name, data in decoded:
+            if is_compact_mesh(file_name, data):
+                error = validate_compact_mesh(data)
+                if error:
+                    self.send_json({"detail": f"invalid compact mesh {file_name}: {error}"}, 400)
+                    return
+                compact_meshes += 1
+
+        files = []
+        for file_name, data in decoded:
+            file_id = self.state.add_file(data)
+            files.append({"file_id": file_id, "file_name": file_name, "size": len(data)})
+
+        with self.state.lock:
+            self.state.stats["uploads"] += 1
+            self.state.stats["uploaded_bytes"] += len(body)
+            self.state.stats["compressed_files"] += compressed_files
+            self.state.stats["decoded_bytes"] += sum(len(data) for _, data in decoded)
+            self.state.stats["compact_meshes"] += compact_meshes
+
+        self.send_json({"files": files})
+
+    def create_upload_session(self, body):
+        try:
+            request = json.loads(body or b"{}")
+        except json.JSONDecodeError:
+            self.send_json({"detail": "invalid json"}, 400)
+            return
+
+        encoding = request.get("content_encoding", "").lower()
+        if encoding and not (encoding == "gzip" and self.state.accept_gzip) and encoding != "identity":
+            self.send_json({"detail": f"unsupported content encoding {encoding}"}, 415)
+            return
+
+        upload_id = "upload_" + uuid.uuid4().hex
+        with self.state.lock:
+            self.state.upload_sessions[upload_id] = {
+                "file_name": request.get("file_name", ""),
+                "size": int(request.get("size", 0)),
+                "encoding": encoding,
+                "data": bytearray(),
+                "file_id": None,
+            }
+            self.state.stats["upload_sessions"] += 1
+
+        self.send_json({"upload_id": upload_id, "offset": 0})
+
+    def upload_session_status(self, upload_id, session):
+        status = {"upload_id": upload_id, "offset": len(session["data"]), "size": session["size"]}
+        if session["file_id"]:
+            status["file_id"] = session["file_id"]
+        return status
+
+    def get_upload_session(self, upload_id):
+        with self.state.lock:
+            session = self.state.upload_sessions.get(upload_id)
+            status = self.upload_session_status(upload_id, session) if session else None
+
+        if status is None:
+            self.send_json({"detail": "upload session not found"}, 404)
+        else:
+            self.send_json(status)
+
+    def put_upload_part(self, upload_id):
+        match = re.search(r"offset=(\d+)", self.path)
+        offset = int(match.group(1)) if match else 0
+        length = int(self.headers.get("Content-Length", 0))
+
+        with self.state.lock:
+            session = self.state.upload_sessions.get(upload_id)
+            expected = len(session["data"]) if session else 0
+
+        if session is None:
+            self.read_body()
+            self.send_json({"detail": "upload session not found"}, 404)
+            return
+
+        if offset != expected:
+            self.read_body()
+            self.send_json(self.upload_session_status(upload_id, session), 409)
+            return
+
+        # Fault injection: keep part of the data and drop the connection as an unreliable link would
+        if random.random() < self.state.fail_rate:
+            received = self.rfile.read(random.randint(0, length)) if length > 0 else b""
+            with self.state.lock:
+                session["data"].extend(received)
+                self.state.stats["injected_faults"] += 1
+            self.close_connection = True
+            self.connection.shutdown(2)
+            return
+
+        data = self.rfile.read(length) if length > 0 else b""
+        with self.state.lock:
+            session["data"].extend(data)
+            self.state.stats["upload_parts"] += 1
+            self.state.stats["uploaded_bytes"] += len(data)
+            complete = len(session["data"]) >= session["size"] and session["file_id"] is None
+
+        if complete:
+            data = bytes(session["data"])
+            if session["encoding"] == "gzip":
+                try:
+                    data = gzip.decompress(data)
+                except OSError:
+                    self.send_json({"detail": "invalid gzip data"}, 400)
+                    return
+                with self.state.lock:
+                    self.state.stats["compressed_files"] += 1
+            if is_compact_mesh(session["file_name"], data):
+                error = validate_compact_mesh(data)
+                if error:
+                    self.send_json({"detail": f"invalid compact mesh {session['file_name']}: {error}"}, 400)
+                    return
+                with self.state.lock:
+                    self.state.stats["compact_meshes"] += 1
+            session["file_id"] = self.state.add_file(data)
+            with self.state.lock:
+                self.state.stats["uploads"] += 1
+                self.state.stats["decoded_bytes"] += len(data)
+
+        self.send_json(self.upload_session_status(upload_id, session))
+
+    def create_job(self, body):
+        try:
+            request = json.loads(body or b"{}")
+        except json.JSONDecodeError:
+            self.send_json({"detail": "invalid json"}, 400)
+            return
+
+        job_id = "job_" + uuid.uuid4().hex
+        input_file_ids = find_input_file_ids(request.get("params", {}))
+
+        with self.state.lock:
+            self.state.jobs[job_id] = {
+                "job_def_id": request.get("job_def_id", ""),
+                "inputs": input_file_ids,
+                "start_time": time.monotonic(),
+                "canceled": False,
+            }
+            self.state.stats["jobs"] += 1
+
+        self.send_json({"job_id": job_id})
+
+    def get_job_results(self, job_id):
+        with self.state.lock:
+            job = self.state.jobs.get(job_id)
+
+        if not job:
+            self.send_json({"detail": "job not found"}, 404)
+            return
+
+        if job["canceled"] or time.monotonic() - job["start_time"] < self.state.latency:
+            self.send_json({"completed": False, "results": []})
+            return
+
+        # Return the configured result, otherwise echo the first input back as the generated mesh
+        result_id = job.get("result_id")
+        if result_id is None:
+            if self.state.result_data is not None:
+                result_id = self.state.add_file(self.state.result_data)
+            elif job["inputs"]:
+                result_id = job["inputs"][0]
+            job["result_id"] = result_id
+
+        if result_id is None:
+            item = {"job_id": job_id, "item_type": "completed"}
+        else:
+            item = {"job_id": job_id, "item_type": "file", "files": {"mesh": [result_id]}}
+
+        self.send_json({"completed": True, "results": [{"result_data": item}]})
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Local stand-in for the Mythica service")
+    parser.add_argument("--host", default="127.0.0.1")
+    parser.add_argument("--port", type=int, default=8080)
+    parser.add_argument("--latency", type=float, default=0.5, help="seconds a job takes to complete")
+    parser.add_argument("--result-file", help="file returned as the result of every job")
+    parser.add_argument("--no-gzip", action="store_true", help="reject gzip encoded uploads with 415")
+    parser.add_argument("--fail-rate", type=float, default=0.0, help="fraction of upload parts dropped part way through")
+    parser.add_argument("--verbose", action="store_true", help="log every request")
+    args = parser.parse_args()
+
+    StandInHandler.state = StandInState(args.latency, args.result_file, not args.no_gzip, args.fail_rate)
+
+    server = ThreadingHTTPServer((args.host, args.port), StandInHandler)
+    server.verbose = args.verbose
+    print(f"Mythica stand-in service listening on http://{args.host}:{args.port}")
+
+    try:
+        server.serve_forever()
+    except KeyboardInterrupt:
+        pass
+    finally:
+        server.server_close()
+
+
+if __name__ == "__main__":
+    main()